@@ -5,9 +5,55 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define NAGI_MT6835_ZERO_REG_STEP    (0.088f)
 #define NAGI_MT6835_ANGLE_RESOLUTION (1 << 21)
 
+/// Raw counts per zero register step, 2^21 / 4096.
+#define NAGI_MT6835_ZERO_REG_RAW_STEP (512)
+
+/// Raw angle to rad, 2 * pi / 2^21, single precision.
+#define NAGI_MT6835_RAW_TO_RAD_F32   (2.996056226329803e-6f)
+
+/// Angle units for @ref nagi_mt6835_angle_t, select one with NAGI_MT6835_ANGLE_UNIT at compile time.
+#define NAGI_MT6835_ANGLE_UNIT_RAD_F32 (0) ///< float rad, single precision only.
+#define NAGI_MT6835_ANGLE_UNIT_Q31     (1) ///< int32_t Q31 turns, 0 - 0x7FFFFC00.
+#define NAGI_MT6835_ANGLE_UNIT_U16     (2) ///< uint16_t turns, 65536 = one turn.
+
+#ifndef NAGI_MT6835_ANGLE_UNIT
+#define NAGI_MT6835_ANGLE_UNIT NAGI_MT6835_ANGLE_UNIT_RAD_F32
+#endif
+
+#define NAGI_MT6835_BURST_MAX        (16)
+
+#define NAGI_MT6835_SHADOW_REG_FIRST (NAGI_MT6835_REG_ID)
+#define NAGI_MT6835_SHADOW_REG_LAST  (NAGI_MT6835_REG_AUTOCAL)
+#define NAGI_MT6835_SHADOW_REG_COUNT (NAGI_MT6835_SHADOW_REG_LAST - NAGI_MT6835_SHADOW_REG_FIRST + 1)
+
+/// Per handle statistics, set to 0 to remove them from the handle and the code paths.
+#ifndef NAGI_MT6835_ENABLE_STATS
+#define NAGI_MT6835_ENABLE_STATS     (0)
+#endif
+
+/// Sample hooks per handle, e.g. a publication, a capture ring and health analytics at once.
+#ifndef NAGI_MT6835_SAMPLE_HOOK_MAX
+#define NAGI_MT6835_SAMPLE_HOOK_MAX  (4)
+#endif
+
+/// Atomic word of the lock free publication and capture ring. C++ sees a plain word of the same
+/// size, it only touches these structures through the C functions.
+#if defined(__cplusplus)
+#define NAGI_MT6835_ATOMIC_U32 uint32_t
+#else
+#define NAGI_MT6835_ATOMIC_U32 _Atomic uint32_t
+#endif
+
+#define NAGI_MT6835_STATS_ERROR_COUNT     (NAGI_MT6835_CRC_CHECK_FAILED + 1)
+#define NAGI_MT6835_STATS_LATENCY_BUCKETS (33)
+
 /// @brief mt6835 error codes.
 typedef enum nagi_mt6835_error_t {
   NAGI_MT6835_OK = 0, ///< No error.
@@ -18,6 +64,16 @@ typedef enum nagi_mt6835_error_t {
   NAGI_MT6835_CRC_CHECK_FAILED, ///< CRC check failed.
 } nagi_mt6835_error_t;
 
+#if NAGI_MT6835_ANGLE_UNIT == NAGI_MT6835_ANGLE_UNIT_RAD_F32
+typedef float nagi_mt6835_angle_t;
+#elif NAGI_MT6835_ANGLE_UNIT == NAGI_MT6835_ANGLE_UNIT_Q31
+typedef int32_t nagi_mt6835_angle_t;
+#elif NAGI_MT6835_ANGLE_UNIT == NAGI_MT6835_ANGLE_UNIT_U16
+typedef uint16_t nagi_mt6835_angle_t;
+#else
+#error "Unknown NAGI_MT6835_ANGLE_UNIT"
+#endif
+
 /// @brief mt6835 command enum.
 typedef enum nagi_mt6835_cmd_enum_t {
   NAGI_MT6835_CMD_RD = (0b0011), ///< User read register.
@@ -58,7 +114,19 @@ typedef enum nagi_mt6835_read_angle_method_enum_t {
   NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE = 1, ///< Continue.
 } nagi_mt6835_read_angle_method_enum_t;
 
+/// @brief Command frame bytes, cmd and register address [11:8], then register address [7:0].
+#define NAGI_MT6835_FRAME_BYTE0(cmd, reg) ((uint8_t)(((cmd) << 4) | (((reg) >> 8) & 0x0F)))
+#define NAGI_MT6835_FRAME_BYTE1(reg)      ((uint8_t)((reg) & 0xFF))
+
+/// @brief Continuous read tx frame initializer, the same frame for every sample.
+#define NAGI_MT6835_CONTINUOUS_READ_TX_INIT                           \
+  {                                                                   \
+    NAGI_MT6835_FRAME_BYTE0(NAGI_MT6835_CMD_CONTINUE, NAGI_MT6835_REG_ANGLE3), \
+    NAGI_MT6835_FRAME_BYTE1(NAGI_MT6835_REG_ANGLE3), 0, 0, 0, 0        \
+  }
+
 /// @brief mt6835 data frame.
+/// @note Bitfield layout is compiler specific, the driver encodes frames byte by byte.
 typedef struct nagi_mt6835_data_frame_t {
   union {
     uint32_t pack;
@@ -81,6 +149,194 @@ typedef int (*nagi_mt6835_read_write_fn_t)(uint8_t *, uint8_t *, size_t);
 /// @brief mt6835 delay function typedef.
 typedef void (*nagi_mt6835_delay_fn_t)(uint32_t);
 
+/// @brief mt6835 non-blocking transfer start function typedef.
+/// @note Starts a transfer (e.g. DMA) and returns at once, completion is reported with
+///       @ref nagi_mt6835_async_transfer_done.
+typedef int (*nagi_mt6835_start_transfer_fn_t)(uint8_t *, uint8_t *, size_t);
+
+/// @brief mt6835 chip select function with user context typedef.
+typedef void (*nagi_mt6835_chip_select_ctx_fn_t)(void *, bool);
+
+/// @brief mt6835 read write function with user context typedef.
+typedef int (*nagi_mt6835_read_write_ctx_fn_t)(void *, uint8_t *, uint8_t *, size_t);
+
+/// @brief mt6835 non-blocking transfer start function with user context typedef.
+typedef int (*nagi_mt6835_start_transfer_ctx_fn_t)(void *, uint8_t *, uint8_t *, size_t);
+
+/// @brief mt6835 cycle counter function typedef.
+/// @note Returns a free running counter, e.g. DWT->CYCCNT, wrapping at 2^32.
+typedef uint32_t (*nagi_mt6835_cycle_counter_fn_t)(void);
+
+/// @brief mt6835 raw angle correction function typedef.
+/// @note Takes the user context and a CRC checked raw angle, returns the corrected raw angle.
+typedef uint32_t (*nagi_mt6835_angle_correct_fn_t)(void *, uint32_t);
+
+/// @brief mt6835 angle prediction function typedef.
+/// @note Takes the user context and the cycle counter, 0 without one, returns a raw angle.
+typedef uint32_t (*nagi_mt6835_angle_predict_fn_t)(void *, uint32_t);
+
+/// @brief mt6835 angle source flags, set by every synchronous and continuous angle read.
+typedef enum nagi_mt6835_angle_flag_enum_t {
+  NAGI_MT6835_ANGLE_FLAG_NONE = 0x00, ///< Measured, first try.
+  NAGI_MT6835_ANGLE_FLAG_RETRIED = 0x01, ///< CRC failures were retried.
+  NAGI_MT6835_ANGLE_FLAG_BUDGET_EXHAUSTED = 0x02, ///< The time budget cut the retries short.
+  NAGI_MT6835_ANGLE_FLAG_LAST_GOOD = 0x04, ///< Not measured, the last valid sample.
+  NAGI_MT6835_ANGLE_FLAG_PREDICTED = 0x08, ///< Not measured, the predicted angle.
+  NAGI_MT6835_ANGLE_FLAG_BUS_ERROR = 0x10, ///< Not measured, the transfer failed.
+} nagi_mt6835_angle_flag_enum_t;
+
+/// @brief mt6835 angle sample, handed to the sample hook after every angle read.
+typedef struct nagi_mt6835_sample_t {
+  /// @brief Raw angle returned by the read. When the read failed it is the last valid one, crc_ok is
+  ///        false and a failed transfer sets NAGI_MT6835_ANGLE_FLAG_BUS_ERROR.
+  uint32_t raw_angle;
+  /// @brief Cycle counter at the read, 0 without one.
+  uint32_t timestamp;
+  /// @brief Sample sequence number, counts every read of the handle.
+  uint32_t seq;
+  /// @brief Warning.
+  nagi_mt6835_warning_t warning;
+  /// @brief Sample passed the CRC check, always true with the CRC check disabled, false on a bus error.
+  bool crc_ok;
+  /// @brief Angle source, @ref nagi_mt6835_angle_flag_enum_t.
+  uint8_t angle_flags;
+} nagi_mt6835_sample_t;
+
+/// @brief mt6835 sample hook function typedef.
+/// @note Takes the user context and the sample, runs in the context of the read, e.g. the DMA ISR.
+typedef void (*nagi_mt6835_sample_fn_t)(void *, const nagi_mt6835_sample_t *);
+
+/// @brief mt6835 sample hook.
+typedef struct nagi_mt6835_sample_hook_t {
+  /// @brief Sample hook function pointer.
+  nagi_mt6835_sample_fn_t fn;
+  /// @brief Sample hook user context.
+  void *ctx;
+} nagi_mt6835_sample_hook_t;
+
+/// @brief mt6835 CRC failure fallback enum.
+typedef enum nagi_mt6835_fallback_enum_t {
+  NAGI_MT6835_FALLBACK_NONE = 0, ///< Return NAGI_MT6835_CRC_CHECK_FAILED.
+  NAGI_MT6835_FALLBACK_LAST_GOOD = 1, ///< Return the last valid sample.
+  NAGI_MT6835_FALLBACK_PREDICTED = 2, ///< Return the predicted angle.
+} nagi_mt6835_fallback_enum_t;
+
+/// @brief mt6835 CRC failure recovery policy.
+/// @note At most 1 + max_retries transactions per read. With a time budget a retry only starts
+///       when one more worst case attempt still fits, so a read never takes longer than the budget.
+typedef struct nagi_mt6835_recovery_t {
+  /// @brief Immediate retries after a CRC failure.
+  uint8_t max_retries;
+  /// @brief Cycles for the whole read including retries, 0 for no limit, needs cycle_counter_fn.
+  uint32_t time_budget;
+  /// @brief Worst case cycles of one attempt, transaction and decode, needed with a time budget
+  ///        and at most time_budget.
+  uint32_t attempt_cycles;
+  /// @brief Fallback once the retries are spent, needs a valid sample since init.
+  nagi_mt6835_fallback_enum_t fallback;
+  /// @brief Consecutive fallback reads before failing again, 0 for no limit.
+  uint32_t max_fallbacks;
+  /// @brief Angle prediction function, e.g. @ref nagi_mt6835_observer_q32_predict.
+  nagi_mt6835_angle_predict_fn_t predict_fn;
+  /// @brief Angle prediction user context.
+  void *predict_ctx;
+} nagi_mt6835_recovery_t;
+
+/// @brief mt6835 asynchronous operation enum.
+typedef enum nagi_mt6835_async_op_enum_t {
+  NAGI_MT6835_ASYNC_OP_GET_RAW_ANGLE = 0, ///< Read raw angle.
+  NAGI_MT6835_ASYNC_OP_READ_REG = 1, ///< Read register.
+  NAGI_MT6835_ASYNC_OP_WRITE_REG = 2, ///< Write register.
+  NAGI_MT6835_ASYNC_OP_AUTO_ZERO = 3, ///< Auto set zero angle.
+  NAGI_MT6835_ASYNC_OP_PROGRAM_EEPROM = 4, ///< Program EEPROM.
+} nagi_mt6835_async_op_enum_t;
+
+/// @brief mt6835 asynchronous request state enum.
+typedef enum nagi_mt6835_async_state_enum_t {
+  NAGI_MT6835_ASYNC_STATE_IDLE = 0, ///< Prepared or completed, not queued.
+  NAGI_MT6835_ASYNC_STATE_QUEUED = 1, ///< Waiting for the bus.
+  NAGI_MT6835_ASYNC_STATE_IN_FLIGHT = 2, ///< Transfer running.
+  NAGI_MT6835_ASYNC_STATE_DONE = 3, ///< Completed, result is valid.
+} nagi_mt6835_async_state_enum_t;
+
+#define NAGI_MT6835_ASYNC_FRAME_MAX (6)
+
+typedef struct nagi_mt6835_async_req_t nagi_mt6835_async_req_t;
+
+/// @brief mt6835 asynchronous request completion function typedef.
+typedef void (*nagi_mt6835_async_done_fn_t)(nagi_mt6835_async_req_t *);
+
+/// @brief mt6835 asynchronous request.
+/// @note Owned by the caller and must stay alive until completed.
+struct nagi_mt6835_async_req_t {
+  /// @brief Operation.
+  nagi_mt6835_async_op_enum_t op;
+  /// @brief Register, for register operations.
+  nagi_mt6835_reg_enum_t reg;
+  /// @brief Register data, written for write, read back for read.
+  uint8_t data;
+  /// @brief Raw angle, for angle read.
+  uint32_t raw_angle;
+  /// @brief Warning, for angle read.
+  nagi_mt6835_warning_t warning;
+  /// @brief Result, valid in done state.
+  nagi_mt6835_error_t result;
+  /// @brief State.
+  volatile nagi_mt6835_async_state_enum_t state;
+
+  /// @brief Tx frame, DMA source.
+  uint8_t tx_data[NAGI_MT6835_ASYNC_FRAME_MAX];
+  /// @brief Rx frame, DMA destination.
+  uint8_t rx_data[NAGI_MT6835_ASYNC_FRAME_MAX];
+  /// @brief Frame size.
+  size_t size;
+
+  /// @brief Completion function, may be NULL.
+  nagi_mt6835_async_done_fn_t done_fn;
+  /// @brief User data for the completion function.
+  void *user_data;
+  /// @brief Next queued request.
+  nagi_mt6835_async_req_t *next;
+};
+
+/// @brief mt6835 statistics API enum, error codes are counted per API.
+typedef enum nagi_mt6835_stats_api_enum_t {
+  NAGI_MT6835_STATS_API_GET_ANGLE = 0, ///< Raw angle read, all angle getters.
+  NAGI_MT6835_STATS_API_CONTINUOUS_READ = 1, ///< Custom continuous read end.
+  NAGI_MT6835_STATS_API_READ_REG = 2, ///< Register read, also from config getters and setters.
+  NAGI_MT6835_STATS_API_WRITE_REG = 3, ///< Register write, also from config setters.
+  NAGI_MT6835_STATS_API_AUTO_ZERO = 4, ///< Auto zero.
+  NAGI_MT6835_STATS_API_PROGRAM_EEPROM = 5, ///< EEPROM program.
+  NAGI_MT6835_STATS_API_ASYNC = 6, ///< Completed asynchronous request.
+  NAGI_MT6835_STATS_API_COUNT = 7,
+} nagi_mt6835_stats_api_enum_t;
+
+/// @brief mt6835 statistics.
+typedef struct nagi_mt6835_stats_t {
+  /// @brief Chip select framed transactions.
+  uint32_t transactions;
+  /// @brief Bytes clocked.
+  uint32_t bytes;
+  /// @brief Decoded angle samples.
+  uint32_t samples;
+  /// @brief Samples failing the CRC check.
+  uint32_t crc_failures;
+  /// @brief Samples with the over speed warning.
+  uint32_t over_speed;
+  /// @brief Samples with the field weak warning.
+  uint32_t field_weak;
+  /// @brief Samples with the under voltage warning.
+  uint32_t under_voltage;
+  /// @brief Reads retried after a CRC failure.
+  uint32_t retries;
+  /// @brief Reads answered by the CRC failure fallback.
+  uint32_t fallbacks;
+  /// @brief Results per API and @ref nagi_mt6835_error_t, unknown transport codes count as ERROR.
+  uint32_t results[NAGI_MT6835_STATS_API_COUNT][NAGI_MT6835_STATS_ERROR_COUNT];
+  /// @brief Transfer latency histogram in cycles, bucket n holds [2^(n - 1), 2^n), bucket 0 holds 0.
+  uint32_t latency[NAGI_MT6835_STATS_LATENCY_BUCKETS];
+} nagi_mt6835_stats_t;
+
 /// @brief mt6835 configuration structure.
 typedef struct nagi_mt6835_config_t {
   /// @brief Chip select function pointer.
@@ -91,6 +347,20 @@ typedef struct nagi_mt6835_config_t {
   nagi_mt6835_delay_fn_t delay_fn;
   /// @brief Enable CRC check.
   bool enable_crc_check;
+  /// @brief Non-blocking transfer start function pointer, optional, for asynchronous requests.
+  nagi_mt6835_start_transfer_fn_t start_transfer_fn;
+
+  /// @brief Chip select function pointer with user context, used instead of chip_select_fn when set.
+  nagi_mt6835_chip_select_ctx_fn_t chip_select_ctx_fn;
+  /// @brief Read write function pointer with user context, used instead of read_write_fn when set.
+  nagi_mt6835_read_write_ctx_fn_t read_write_ctx_fn;
+  /// @brief Transfer start function pointer with user context, used instead of start_transfer_fn when set.
+  nagi_mt6835_start_transfer_ctx_fn_t start_transfer_ctx_fn;
+  /// @brief User context passed to the context function pointers.
+  void *user_ctx;
+
+  /// @brief Cycle counter function pointer, optional, for latency statistics.
+  nagi_mt6835_cycle_counter_fn_t cycle_counter_fn;
 } nagi_mt6835_config_t;
 
 /// @brief mt6835 structure.
@@ -104,16 +374,109 @@ typedef struct nagi_mt6835_t {
   /// @brief Enable CRC check.
   bool enable_crc_check;
 
-  /// @brief Data frame.
-  nagi_mt6835_data_frame_t data_frame;
   /// @brief CRC result.
   bool crc_res;
   /// @brief Warning.
   nagi_mt6835_warning_t warning;
   /// @brief Is in custom continuous read mode.
   bool is_custom_continuous_reading;
+
+  /// @brief Shadow copy of registers 0x001 - 0x00E.
+  uint8_t shadow_regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  /// @brief Shadow register valid mask, bit n for register n.
+  uint16_t shadow_valid;
+
+  /// @brief Non-blocking transfer start function pointer.
+  nagi_mt6835_start_transfer_fn_t start_transfer_fn;
+  /// @brief Asynchronous request in flight, head of the queue.
+  nagi_mt6835_async_req_t *async_head;
+  /// @brief Last queued asynchronous request.
+  nagi_mt6835_async_req_t *async_tail;
+
+  /// @brief Chip select function pointer with user context.
+  nagi_mt6835_chip_select_ctx_fn_t chip_select_ctx_fn;
+  /// @brief Read write function pointer with user context.
+  nagi_mt6835_read_write_ctx_fn_t read_write_ctx_fn;
+  /// @brief Transfer start function pointer with user context.
+  nagi_mt6835_start_transfer_ctx_fn_t start_transfer_ctx_fn;
+  /// @brief User context.
+  void *user_ctx;
+
+  /// @brief Raw angle correction function pointer, NULL for none.
+  nagi_mt6835_angle_correct_fn_t angle_correct_fn;
+  /// @brief Raw angle correction user context.
+  void *angle_correct_ctx;
+  /// @brief Software zero, the corrected raw angle that reads 0.
+  uint32_t soft_zero;
+  /// @brief Software direction reversed.
+  bool soft_reverse;
+
+  /// @brief Cycle counter function pointer.
+  nagi_mt6835_cycle_counter_fn_t cycle_counter_fn;
+
+  /// @brief CRC failure recovery policy.
+  nagi_mt6835_recovery_t recovery;
+  /// @brief Source of the last angle, @ref nagi_mt6835_angle_flag_enum_t.
+  uint8_t angle_flags;
+  /// @brief Last valid sample is set.
+  bool last_good_valid;
+  /// @brief Last valid sample, corrected raw angle.
+  uint32_t last_good_raw_angle;
+  /// @brief Consecutive fallback reads.
+  uint32_t fallback_count;
+
+  /// @brief Sample hooks, called in order.
+  nagi_mt6835_sample_hook_t sample_hooks[NAGI_MT6835_SAMPLE_HOOK_MAX];
+  /// @brief Sample hooks set.
+  uint8_t sample_hook_count;
+  /// @brief Sample sequence number.
+  uint32_t sample_seq;
+#if NAGI_MT6835_ENABLE_STATS
+  /// @brief Statistics.
+  volatile nagi_mt6835_stats_t stats;
+  /// @brief Statistics update sequence, odd while an update is running.
+  volatile uint32_t stats_seq;
+  /// @brief Cycle counter at the start of the asynchronous transfer in flight.
+  uint32_t async_start_cycle;
+#endif
 } nagi_mt6835_t;
 
+/// @brief CRC8 lookup table, polynomial 0x07, the reference for every CRC kernel.
+extern const uint8_t nagi_mt6835_crc8_table[256];
+
+/// @brief Continuous read tx frame, 6 bytes, constant so it can stay in flash as the DMA source.
+/// @note Clock 5 bytes of it with the CRC check disabled.
+extern const uint8_t nagi_mt6835_continuous_read_tx[6];
+
+/// @brief Decode a continuous read rx frame, a pure function of the frame, no checks.
+/// @note Skips the handle, so no angle correction, recovery, statistics or sample hook.
+/// @param[in] rx_data rx frame, 6 bytes with CRC check, 5 without.
+/// @param[in] check_crc check the CRC byte.
+/// @param[out] praw_angle raw angle, only set when the CRC check passes.
+/// @param[out] pwarning warning.
+/// @return mt6835 error code.
+static inline nagi_mt6835_error_t nagi_mt6835_continuous_read_decode(
+  const uint8_t *rx_data,
+  bool check_crc,
+  uint32_t *praw_angle,
+  nagi_mt6835_warning_t *pwarning
+) {
+  const uint8_t *angle = rx_data + 2;
+
+  *pwarning = (nagi_mt6835_warning_t)(angle[2] & 0x07);
+  if (check_crc) {
+    uint8_t crc = nagi_mt6835_crc8_table[angle[0]];
+    crc = nagi_mt6835_crc8_table[crc ^ angle[1]];
+    crc = nagi_mt6835_crc8_table[crc ^ angle[2]];
+    if (crc != angle[3]) {
+      return NAGI_MT6835_CRC_CHECK_FAILED;
+    }
+  }
+
+  *praw_angle = ((uint32_t)angle[0] << 13) | ((uint32_t)angle[1] << 5) | ((uint32_t)angle[2] >> 3);
+  return NAGI_MT6835_OK;
+}
+
 /// @brief Initialize the mt6835.
 /// @param[in] pmt6835 mt6835 handle.
 /// @param[in] config mt6835 configuration.
@@ -144,6 +507,7 @@ nagi_mt6835_error_t nagi_mt6835_auto_zero_angle(nagi_mt6835_t *pmt6835);
 nagi_mt6835_error_t nagi_mt6835_set_zero_angle(nagi_mt6835_t *pmt6835, float rad);
 
 /// @brief Get raw angle from mt6835.
+/// @note CRC failures go through the recovery policy, angle_flags tells where the angle came from.
 /// @param[in] pmt6835 mt6835 handle.
 /// @param[in] method read angle method.
 /// @param[out] praw_angle raw angle.
@@ -171,6 +535,125 @@ nagi_mt6835_error_t nagi_mt6835_get_angle(
   float *prad_angle
 );
 
+/// @brief Get angle from mt6835 as Q31 turns.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[out] pq31_angle angle, 0x80000000 = one turn.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_get_angle_q31(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  int32_t *pq31_angle
+);
+
+/// @brief Get angle from mt6835 as 16-bit turns, ready for electrical angle math.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[out] pu16_angle angle, 65536 = one turn.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_get_angle_u16(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  uint16_t *pu16_angle
+);
+
+/// @brief Get angle from mt6835 in the compile time unit NAGI_MT6835_ANGLE_UNIT.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[out] pangle angle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_get_angle_unit(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  nagi_mt6835_angle_t *pangle
+);
+
+/// @brief Set the raw angle correction run by every angle getter, e.g. a calibration table.
+/// @note Also runs for continuous read and asynchronous angle reads.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] correct_fn correction function, NULL to disable.
+/// @param[in] ctx correction user context.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_set_angle_correction(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_angle_correct_fn_t correct_fn,
+  void *ctx
+);
+
+/// @brief Set the software zero and direction of the angle reads.
+/// @note No bus traffic and full 21-bit resolution. Reads return (raw_angle - raw_zero) mod 2^21,
+///       or (raw_zero - raw_angle) mod 2^21 reversed, after the angle correction. The last valid
+///       sample is moved along, so a fallback after the change is still in the new frame.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] raw_zero corrected raw angle that reads 0, below NAGI_MT6835_ANGLE_RESOLUTION.
+/// @param[in] reverse count against the chip direction.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_set_soft_zero(nagi_mt6835_t *pmt6835, uint32_t raw_zero, bool reverse);
+
+/// @brief Move the software zero so an angle as returned by the reads becomes 0, e.g. at homing.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] raw_angle angle in the current frame, as returned by the reads.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_shift_soft_zero(nagi_mt6835_t *pmt6835, uint32_t raw_angle);
+
+/// @brief Get the software zero and direction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] praw_zero corrected raw angle that reads 0.
+/// @param[out] preverse direction reversed, may be NULL.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_get_soft_zero(const nagi_mt6835_t *pmt6835, uint32_t *praw_zero, bool *preverse);
+
+/// @brief Fold the software zero into the chip zero register, for persistence.
+/// @note The register has NAGI_MT6835_ZERO_REG_RAW_STEP resolution, the remainder of at most half a
+///       step stays in software, so the reads do not move. The direction stays in software. The
+///       angle correction then sees the new chip zero, refit it if it is not shift invariant. Two
+///       register reads, none with valid shadow registers, two writes and the optional EEPROM program.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] program_eeprom program the EEPROM after the register writes.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_fold_soft_zero(nagi_mt6835_t *pmt6835, bool program_eeprom);
+
+/// @brief Set the CRC failure recovery policy of the angle reads.
+/// @note Custom continuous reads only take the fallback, the caller owns their transfers.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] precovery recovery policy, copied, NULL to fail on every CRC error again.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_set_recovery(nagi_mt6835_t *pmt6835, const nagi_mt6835_recovery_t *precovery);
+
+/// @brief Set the hook handed every angle sample, e.g. a lock free publication, replacing all hooks.
+/// @note Runs for synchronous, continuous and asynchronous angle reads.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] sample_fn sample hook, NULL to remove all hooks.
+/// @param[in] ctx sample hook user context.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_set_sample_hook(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
+);
+
+/// @brief Add a sample hook after the ones already set, a hook already set is not added twice.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] sample_fn sample hook.
+/// @param[in] ctx sample hook user context.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when NAGI_MT6835_SAMPLE_HOOK_MAX hooks are set.
+nagi_mt6835_error_t nagi_mt6835_add_sample_hook(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
+);
+
+/// @brief Remove sample hooks, the others keep their order.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] sample_fn sample hook.
+/// @param[in] ctx sample hook user context, NULL for every hook with sample_fn.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_remove_sample_hook(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
+);
+
 /// @brief Get zero angle from mt6835.
 /// @param[in] pmt6835 mt6835 handle.
 /// @param[out] prad_angle zero angle in rad.
@@ -242,8 +725,72 @@ nagi_mt6835_error_t nagi_mt6835_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg
 /// @return mt6835 error code.
 nagi_mt6835_error_t nagi_mt6835_write_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t data);
 
+/// @brief Read contiguous mt6835 registers in one chip select framed transaction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] reg first register.
+/// @param[out] pdata data, count bytes.
+/// @param[in] count register count(1 - NAGI_MT6835_BURST_MAX).
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_read_regs(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t *pdata,
+  size_t count
+);
+
+/// @brief Write contiguous mt6835 registers.
+/// @note The chip has no burst write, every register is still one transaction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] reg first register.
+/// @param[in] pdata data, count bytes.
+/// @param[in] count register count(1 - NAGI_MT6835_BURST_MAX).
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_write_regs(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_reg_enum_t reg,
+  const uint8_t *pdata,
+  size_t count
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions manage the shadow register copy.
+/// While the copy is valid the setters only write, skipping the read of read-modify-write.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Read registers 0x001 - 0x00E into the shadow copy and mark it valid.
+/// @note Angle and CRC registers are never cached.
+/// @param[in] pmt6835 mt6835 handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sync_shadow_regs(nagi_mt6835_t *pmt6835);
+
+/// @brief Invalidate the shadow copy, setters go back to read-modify-write.
+/// @note Call after anything outside the driver changes the registers, e.g. a power cycle.
+/// @param[in] pmt6835 mt6835 handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_invalidate_shadow_regs(nagi_mt6835_t *pmt6835);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions access the statistics, NAGI_MT6835_ERROR when built without NAGI_MT6835_ENABLE_STATS.
+/// Both are safe from interrupts. When the interrupt preempted a driver call on the same handle they
+/// return NAGI_MT6835_ERROR and leave everything untouched, call again later.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Get a consistent copy of the statistics.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] pstats statistics.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_get_stats(const nagi_mt6835_t *pmt6835, nagi_mt6835_stats_t *pstats);
+
+/// @brief Clear the statistics.
+/// @param[in] pmt6835 mt6835 handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_reset_stats(nagi_mt6835_t *pmt6835);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Below functions are for custom SPI communication to read angle data.
+/// For a continuous read loop without CPU work per sample, point the DMA at
+/// nagi_mt6835_continuous_read_tx and decode with nagi_mt6835_continuous_read_decode, or with
+/// nagi_mt6835_custom_continuous_read_end_raw to keep correction, recovery and the sample hook.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// @brief Perpare continuous read command.
@@ -266,4 +813,134 @@ nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end(
   float *pangle
 );
 
+/// @brief Get continuous read raw angle, integer only.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] rx_data rx data.
+/// @param[in] rx_size rx size.
+/// @param[out] praw_angle raw angle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end_raw(
+  nagi_mt6835_t *pmt6835,
+  const uint8_t *rx_data,
+  size_t rx_size,
+  uint32_t *praw_angle
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions are for asynchronous (DMA) transactions.
+/// Either run the frame yourself: prepare, assert CS, transfer tx_data/rx_data/size, deassert CS,
+/// then call nagi_mt6835_async_complete. Or configure start_transfer_fn, submit requests and call
+/// nagi_mt6835_async_transfer_done from the transfer complete interrupt.
+/// Do not mix blocking calls with asynchronous requests in flight on the same bus.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Prepare asynchronous raw angle read.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] preq request.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_prepare_get_raw_angle(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq);
+
+/// @brief Prepare asynchronous register read.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] preq request.
+/// @param[in] reg register.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_prepare_read_reg(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq,
+  nagi_mt6835_reg_enum_t reg
+);
+
+/// @brief Prepare asynchronous register write.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] preq request.
+/// @param[in] reg register.
+/// @param[in] data data.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_prepare_write_reg(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t data
+);
+
+/// @brief Prepare asynchronous auto zero.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] preq request.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_prepare_auto_zero_angle(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq);
+
+/// @brief Prepare asynchronous EEPROM program.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[out] preq request.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_prepare_program_eeprom(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq);
+
+/// @brief Decode a finished request and call its completion function.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] preq request with rx_data filled.
+/// @return request result.
+nagi_mt6835_error_t nagi_mt6835_async_complete(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq);
+
+/// @brief Queue a prepared request, starts it at once when the bus is idle.
+/// @note Call with the transfer complete interrupt masked, or from the same priority.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] preq request.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_submit(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq);
+
+/// @brief Report the running transfer finished, completes it and starts the next request.
+/// @note Call from the transfer (DMA) complete interrupt.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] transfer_err transfer error code, 0 on success.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_async_transfer_done(nagi_mt6835_t *pmt6835, int transfer_err);
+
+/// @brief Check no asynchronous request is queued or in flight.
+/// @param[in] pmt6835 mt6835 handle.
+/// @return true if idle.
+bool nagi_mt6835_async_idle(const nagi_mt6835_t *pmt6835);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions convert raw angles. None of them use double math or libm.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Convert raw angle to Q31 turns.
+/// @param[in] raw_angle raw angle.
+/// @return angle, 0x80000000 = one turn.
+static inline int32_t nagi_mt6835_raw_to_q31(uint32_t raw_angle) {
+  return (int32_t)((raw_angle & (NAGI_MT6835_ANGLE_RESOLUTION - 1)) << 10);
+}
+
+/// @brief Convert raw angle to 16-bit turns.
+/// @param[in] raw_angle raw angle.
+/// @return angle, 65536 = one turn.
+static inline uint16_t nagi_mt6835_raw_to_u16(uint32_t raw_angle) {
+  return (uint16_t)(raw_angle >> 5);
+}
+
+/// @brief Convert raw angle to rad in single precision.
+/// @param[in] raw_angle raw angle.
+/// @return angle in rad.
+static inline float nagi_mt6835_raw_to_rad_f32(uint32_t raw_angle) {
+  return (float)raw_angle * NAGI_MT6835_RAW_TO_RAD_F32;
+}
+
+/// @brief Convert raw angle to the compile time unit NAGI_MT6835_ANGLE_UNIT.
+/// @param[in] raw_angle raw angle.
+/// @return angle.
+static inline nagi_mt6835_angle_t nagi_mt6835_raw_to_angle(uint32_t raw_angle) {
+#if NAGI_MT6835_ANGLE_UNIT == NAGI_MT6835_ANGLE_UNIT_RAD_F32
+  return nagi_mt6835_raw_to_rad_f32(raw_angle);
+#elif NAGI_MT6835_ANGLE_UNIT == NAGI_MT6835_ANGLE_UNIT_Q31
+  return nagi_mt6835_raw_to_q31(raw_angle);
+#else
+  return nagi_mt6835_raw_to_u16(raw_angle);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // __NAGI_MT6835_H__
\ No newline at end of file
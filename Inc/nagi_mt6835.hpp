@@ -0,0 +1,256 @@
+#ifndef __NAGI_MT6835_HPP__
+#define __NAGI_MT6835_HPP__
+
+/// C++17 header-only mt6835 driver with compile time transport, CRC and angle unit.
+///
+/// struct board_spi {
+///   void chip_select(bool select) noexcept { ... }
+///   int read_write(const uint8_t *tx, uint8_t *rx, size_t size) noexcept { ...; return 0; }
+/// };
+///
+/// nagi::mt6835<board_spi, nagi::mt6835_crc_check, nagi::mt6835_unit_q31> encoder{board_spi{}};
+/// int32_t angle;
+/// nagi_mt6835_error_t err = encoder.get_angle(angle);
+///
+/// The transport is held by value and called directly, so its calls inline. Frames are the C
+/// driver frames, built at compile time, and the CRC uses nagi_mt6835_crc8_table, so link
+/// nagi_mt6835.c. Like @ref nagi_mt6835_continuous_read_decode there is no angle correction,
+/// recovery, statistics or sample hook.
+///
+/// Tools/nagi_mt6835_hpp_smoke.cpp builds it with every C header against the C objects.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+extern "C" {
+#include "nagi_mt6835.h"
+}
+
+namespace nagi {
+
+/// @brief Encode a 3 byte command frame.
+/// @param cmd command.
+/// @param reg register address.
+/// @param data data byte.
+/// @return frame.
+constexpr std::array<uint8_t, 3> mt6835_encode_frame(
+  nagi_mt6835_cmd_enum_t cmd,
+  uint16_t reg,
+  uint8_t data = 0
+) noexcept {
+  return {NAGI_MT6835_FRAME_BYTE0(cmd, reg), NAGI_MT6835_FRAME_BYTE1(reg), data};
+}
+
+/// @brief Continuous read tx frame.
+inline constexpr std::array<uint8_t, 6> mt6835_continuous_read_tx = NAGI_MT6835_CONTINUOUS_READ_TX_INIT;
+
+/// @brief CRC policy, check the CRC byte of every angle frame.
+struct mt6835_crc_check {
+  static constexpr bool enabled = true;
+  static constexpr size_t frame_size = 6;
+};
+
+/// @brief CRC policy, skip the CRC byte, one byte shorter frames.
+struct mt6835_crc_none {
+  static constexpr bool enabled = false;
+  static constexpr size_t frame_size = 5;
+};
+
+/// @brief Angle unit, raw counts.
+struct mt6835_unit_raw {
+  using value_type = uint32_t;
+  static value_type from_raw(uint32_t raw_angle) noexcept { return raw_angle; }
+};
+
+/// @brief Angle unit, float rad.
+struct mt6835_unit_rad_f32 {
+  using value_type = float;
+  static value_type from_raw(uint32_t raw_angle) noexcept { return nagi_mt6835_raw_to_rad_f32(raw_angle); }
+};
+
+/// @brief Angle unit, Q31 turns.
+struct mt6835_unit_q31 {
+  using value_type = int32_t;
+  static value_type from_raw(uint32_t raw_angle) noexcept { return nagi_mt6835_raw_to_q31(raw_angle); }
+};
+
+/// @brief Angle unit, 16-bit turns.
+struct mt6835_unit_u16 {
+  using value_type = uint16_t;
+  static value_type from_raw(uint32_t raw_angle) noexcept { return nagi_mt6835_raw_to_u16(raw_angle); }
+};
+
+/// @brief Transport over the C context callbacks, e.g. the simulator, one indirect call per use.
+struct mt6835_ctx_transport {
+  nagi_mt6835_chip_select_ctx_fn_t chip_select_fn;
+  nagi_mt6835_read_write_ctx_fn_t read_write_fn;
+  void *ctx;
+
+  void chip_select(bool select) noexcept { chip_select_fn(ctx, select); }
+
+  /// @brief The C callback takes a mutable tx buffer, it gets a copy, never the constexpr frames.
+  int read_write(const uint8_t *tx_data, uint8_t *rx_data, size_t size) noexcept {
+    uint8_t tx_copy[6];
+    if (size > sizeof(tx_copy)) {
+      return NAGI_MT6835_INVALID_ARGUMENT;
+    }
+    std::memcpy(tx_copy, tx_data, size);
+    return read_write_fn(ctx, tx_copy, rx_data, size);
+  }
+};
+
+/// @brief mt6835 driver.
+/// @tparam Transport chip_select(bool) and int read_write(const uint8_t *, uint8_t *, size_t), 0 on success.
+/// @tparam CrcPolicy @ref mt6835_crc_check or @ref mt6835_crc_none.
+/// @tparam AngleUnit @ref mt6835_unit_raw, @ref mt6835_unit_rad_f32, @ref mt6835_unit_q31 or
+///         @ref mt6835_unit_u16.
+template <typename Transport, typename CrcPolicy = mt6835_crc_check, typename AngleUnit = mt6835_unit_rad_f32>
+class mt6835 {
+public:
+  using transport_type = Transport;
+  using angle_type = typename AngleUnit::value_type;
+
+  /// @brief Angle frame size, also the stride of @ref decode.
+  static constexpr size_t frame_size = CrcPolicy::frame_size;
+
+  explicit mt6835(Transport transport) noexcept : transport_(std::move(transport)) {}
+
+  Transport &transport() noexcept { return transport_; }
+
+  /// @brief Last warning.
+  nagi_mt6835_warning_t warning() const noexcept { return warning_; }
+
+  /// @brief Read the raw angle.
+  /// @param[out] raw_angle raw angle, only set on success.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t get_raw_angle(uint32_t &raw_angle) noexcept {
+    uint8_t rx_data[6];
+    const nagi_mt6835_error_t err = transfer(mt6835_continuous_read_tx.data(), rx_data, frame_size);
+    if (err != NAGI_MT6835_OK) {
+      return err;
+    }
+    return nagi_mt6835_continuous_read_decode(rx_data, CrcPolicy::enabled, &raw_angle, &warning_);
+  }
+
+  /// @brief Read the angle in the unit of the driver.
+  /// @param[out] angle angle, only set on success.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t get_angle(angle_type &angle) noexcept {
+    uint32_t raw_angle = 0;
+    const nagi_mt6835_error_t err = get_raw_angle(raw_angle);
+    if (err == NAGI_MT6835_OK) {
+      angle = AngleUnit::from_raw(raw_angle);
+    }
+    return err;
+  }
+
+  /// @brief Read a register.
+  /// @param[in] reg register.
+  /// @param[out] data data.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t read_reg(nagi_mt6835_reg_enum_t reg, uint8_t &data) noexcept {
+    const std::array<uint8_t, 3> tx_data = mt6835_encode_frame(NAGI_MT6835_CMD_RD, reg);
+    uint8_t rx_data[3];
+    const nagi_mt6835_error_t err = transfer(tx_data.data(), rx_data, 3);
+    if (err == NAGI_MT6835_OK) {
+      data = rx_data[2];
+    }
+    return err;
+  }
+
+  /// @brief Write a register.
+  /// @param[in] reg register.
+  /// @param[in] data data.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t write_reg(nagi_mt6835_reg_enum_t reg, uint8_t data) noexcept {
+    const std::array<uint8_t, 3> tx_data = mt6835_encode_frame(NAGI_MT6835_CMD_WR, reg, data);
+    uint8_t rx_data[3];
+    return transfer(tx_data.data(), rx_data, 3);
+  }
+
+  /// @brief Set the zero angle to the current angle.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t auto_zero_angle() noexcept { return acked(NAGI_MT6835_CMD_ZERO); }
+
+  /// @brief Program the registers into the EEPROM.
+  /// @return mt6835 error code.
+  nagi_mt6835_error_t program_eeprom() noexcept { return acked(NAGI_MT6835_CMD_EEPROM); }
+
+  /// @brief Decode angle frames packed back to back, frame_size bytes each, e.g. a DMA rx buffer.
+  /// @param[in] frames frames.
+  /// @param[in] count frame count.
+  /// @param[out] raw_angles raw angles, count entries, set for failed frames too.
+  /// @param[out] crc_pass 1 if the CRC passed or the policy skips it, else 0, count entries.
+  /// @return passed frame count.
+  static size_t decode(const uint8_t *frames, size_t count, uint32_t *raw_angles, uint8_t *crc_pass) noexcept {
+    size_t pass_count = 0;
+    for (size_t i = 0; i < count; i++) {
+      const uint8_t *angle = frames + i * frame_size + 2;
+      raw_angles[i] = (static_cast<uint32_t>(angle[0]) << 13) | (static_cast<uint32_t>(angle[1]) << 5) |
+                      (static_cast<uint32_t>(angle[2]) >> 3);
+      bool pass = true;
+      if constexpr (CrcPolicy::enabled) {
+        uint8_t crc = nagi_mt6835_crc8_table[angle[0]];
+        crc = nagi_mt6835_crc8_table[crc ^ angle[1]];
+        crc = nagi_mt6835_crc8_table[crc ^ angle[2]];
+        pass = crc == angle[3];
+      }
+      crc_pass[i] = pass ? 1 : 0;
+      pass_count += pass ? 1 : 0;
+    }
+    return pass_count;
+  }
+
+#if defined(__cpp_lib_span)
+  /// @brief Decode angle frames, as many as all spans hold.
+  /// @param[in] frames frames, frame_size bytes each.
+  /// @param[out] raw_angles raw angles.
+  /// @param[out] crc_pass CRC pass flags.
+  /// @return passed frame count.
+  static size_t decode(
+    std::span<const uint8_t> frames,
+    std::span<uint32_t> raw_angles,
+    std::span<uint8_t> crc_pass
+  ) noexcept {
+    size_t count = frames.size() / frame_size;
+    count = count < raw_angles.size() ? count : raw_angles.size();
+    count = count < crc_pass.size() ? count : crc_pass.size();
+    return decode(frames.data(), count, raw_angles.data(), crc_pass.data());
+  }
+#endif
+
+private:
+  nagi_mt6835_error_t transfer(const uint8_t *tx_data, uint8_t *rx_data, size_t size) noexcept {
+    transport_.chip_select(true);
+    const int err = transport_.read_write(tx_data, rx_data, size);
+    transport_.chip_select(false);
+    return static_cast<nagi_mt6835_error_t>(err);
+  }
+
+  nagi_mt6835_error_t acked(nagi_mt6835_cmd_enum_t cmd) noexcept {
+    const std::array<uint8_t, 3> tx_data = mt6835_encode_frame(cmd, 0x000);
+    uint8_t rx_data[3] = {0, 0, 0};
+    const nagi_mt6835_error_t err = transfer(tx_data.data(), rx_data, 3);
+    if (err != NAGI_MT6835_OK) {
+      return err;
+    }
+    return rx_data[2] == 0x55 ? NAGI_MT6835_OK : NAGI_MT6835_ERROR;
+  }
+
+  Transport transport_;
+  nagi_mt6835_warning_t warning_ = NAGI_MT6835_WARN_NONE;
+};
+
+static_assert(mt6835_encode_frame(NAGI_MT6835_CMD_RD, NAGI_MT6835_REG_ID)[0] == 0x30, "read frame");
+static_assert(mt6835_continuous_read_tx[0] == 0xA0 && mt6835_continuous_read_tx[1] == 0x03, "continuous read frame");
+
+} // namespace nagi
+
+#endif // __NAGI_MT6835_HPP__
@@ -0,0 +1,98 @@
+#ifndef __NAGI_MT6835_BATCH_H__
+#define __NAGI_MT6835_BATCH_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Continuous read frame: 2 command bytes, ANGLE3, ANGLE2, ANGLE1, CRC.
+#define NAGI_MT6835_FRAME_SIZE (6)
+
+/// Bitmap words needed for count frames, bit n % 32 of word n / 32 is frame n.
+#define NAGI_MT6835_BATCH_BITMAP_WORDS(count) (((count) + 31) / 32)
+
+/// @brief Continuous read rx ring, filled frame by frame by a circular DMA.
+typedef struct nagi_mt6835_batch_ring_t {
+  /// @brief Ring storage, frame_count * frame_size bytes.
+  const uint8_t *buffer;
+  /// @brief Frames in the ring.
+  size_t frame_count;
+  /// @brief Frame size, NAGI_MT6835_FRAME_SIZE, or one less without CRC.
+  size_t frame_size;
+  /// @brief Next frame to decode.
+  size_t read_index;
+} nagi_mt6835_batch_ring_t;
+
+/// @brief Compute the mt6835 CRC8 with the reference table.
+/// @param[in] data data.
+/// @param[in] len data length.
+/// @return CRC8.
+uint8_t nagi_mt6835_crc8(const uint8_t *data, size_t len);
+
+/// @brief Check the CRC of an array of continuous read frames.
+/// @note Frames are packed back to back, NAGI_MT6835_FRAME_SIZE bytes each, as captured from rx.
+/// @param[in] frames frames.
+/// @param[in] count frame count.
+/// @param[out] pass_bitmap CRC pass bitmap, NAGI_MT6835_BATCH_BITMAP_WORDS(count) words.
+/// @param[out] raw_angles raw angle of every frame, count entries, NULL if not needed.
+/// @param[out] ppass_count passed frame count, NULL if not needed.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_batch_check_frames(
+  const uint8_t *frames,
+  size_t count,
+  uint32_t *pass_bitmap,
+  uint32_t *raw_angles,
+  size_t *ppass_count
+);
+
+/// @brief Initialize a continuous read rx ring.
+/// @param[out] pring ring.
+/// @param[in] buffer ring storage, the DMA rx buffer.
+/// @param[in] frame_count frames in the ring.
+/// @param[in] frame_size frame size, NAGI_MT6835_FRAME_SIZE, or one less without CRC.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_batch_ring_init(
+  nagi_mt6835_batch_ring_t *pring,
+  const uint8_t *buffer,
+  size_t frame_count,
+  size_t frame_size
+);
+
+/// @brief Decode the frames received since the last call, oldest first, in place.
+/// @note No mt6835 handle is touched. Call at least once per ring lap, a full lap reads as empty.
+///       Frames beyond max_count are left for the next call.
+/// @param[in] pring ring.
+/// @param[in] write_index frame the DMA is filling, e.g. (buffer size - NDTR) / frame_size.
+/// @param[in] max_count output array size.
+/// @param[out] raw_angles raw angles.
+/// @param[out] warnings warning bits, @ref nagi_mt6835_warning_t.
+/// @param[out] crc_pass 1 if the CRC passed or the frames carry no CRC, else 0.
+/// @param[out] pcount decoded frame count.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_batch_ring_decode(
+  nagi_mt6835_batch_ring_t *pring,
+  size_t write_index,
+  size_t max_count,
+  uint32_t *raw_angles,
+  uint8_t *warnings,
+  uint8_t *crc_pass,
+  size_t *pcount
+);
+
+/// @brief Get the name of the compiled CRC kernel.
+/// @return "ssse3" or "slice3".
+const char *nagi_mt6835_batch_kernel_name(void);
+
+/// @brief Check the compiled kernel against @ref nagi_mt6835_crc8_table for all 2^24 angle bytes.
+/// @note Runs every angle with its correct CRC and with a corrupted CRC, meant for host tests, e.g.
+///       Tools/nagi_mt6835_batch_check.c.
+/// @return number of mismatching frames, 0 if the kernel is bit exact.
+uint32_t nagi_mt6835_batch_verify_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_BATCH_H__
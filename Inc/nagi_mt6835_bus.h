@@ -0,0 +1,123 @@
+#ifndef __NAGI_MT6835_BUS_H__
+#define __NAGI_MT6835_BUS_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief mt6835 bus slot policy enum.
+/// @note A cycle is a fixed sequence of slots, one transaction per slot. Every device gets exactly
+///       one angle slot per cycle at a fixed position, config writes only use their own slots.
+typedef enum nagi_mt6835_bus_policy_enum_t {
+  NAGI_MT6835_BUS_POLICY_PRIORITY = 0, ///< All angle slots first, then the config slots.
+  NAGI_MT6835_BUS_POLICY_ROUND_ROBIN = 1, ///< One config slot after every angle slot.
+} nagi_mt6835_bus_policy_enum_t;
+
+/// @brief mt6835 bus angle sample.
+typedef struct nagi_mt6835_bus_sample_t {
+  /// @brief Raw angle.
+  uint32_t raw_angle;
+  /// @brief Warning.
+  nagi_mt6835_warning_t warning;
+  /// @brief Read result.
+  nagi_mt6835_error_t err;
+  /// @brief Cycle the sample was taken in.
+  uint32_t cycle;
+} nagi_mt6835_bus_sample_t;
+
+/// @brief mt6835 bus pending config write.
+typedef struct nagi_mt6835_bus_write_t {
+  /// @brief Device index.
+  uint8_t device;
+  /// @brief Register.
+  nagi_mt6835_reg_enum_t reg;
+  /// @brief Data.
+  uint8_t data;
+} nagi_mt6835_bus_write_t;
+
+/// @brief mt6835 bus configuration.
+typedef struct nagi_mt6835_bus_config_t {
+  /// @brief Initialized device handles sharing the bus.
+  nagi_mt6835_t **devices;
+  /// @brief Number of devices.
+  size_t device_count;
+  /// @brief Sample storage, device_count entries.
+  nagi_mt6835_bus_sample_t *samples;
+  /// @brief Config write queue storage.
+  nagi_mt6835_bus_write_t *write_queue;
+  /// @brief Config write queue size.
+  size_t write_queue_size;
+  /// @brief Slot policy.
+  nagi_mt6835_bus_policy_enum_t policy;
+  /// @brief Config slots per cycle for priority policy, round robin uses device_count.
+  size_t config_slots;
+  /// @brief Angle read method.
+  nagi_mt6835_read_angle_method_enum_t method;
+} nagi_mt6835_bus_config_t;
+
+/// @brief mt6835 bus scheduler structure.
+typedef struct nagi_mt6835_bus_t {
+  /// @brief Configuration.
+  nagi_mt6835_bus_config_t config;
+  /// @brief Slots per cycle.
+  size_t slots_per_cycle;
+  /// @brief Next slot in the cycle.
+  size_t slot;
+  /// @brief Completed cycles.
+  uint32_t cycle;
+  /// @brief Write queue read index.
+  size_t write_head;
+  /// @brief Write queue entry count.
+  size_t write_count;
+  /// @brief Failed config writes.
+  uint32_t write_errors;
+} nagi_mt6835_bus_t;
+
+/// @brief Initialize the bus scheduler.
+/// @param[in] pbus bus handle.
+/// @param[in] pconfig bus configuration.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_bus_init(nagi_mt6835_bus_t *pbus, const nagi_mt6835_bus_config_t *pconfig);
+
+/// @brief Queue a config register write for a device.
+/// @param[in] pbus bus handle.
+/// @param[in] device device index.
+/// @param[in] reg register.
+/// @param[in] data data.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when the queue is full.
+nagi_mt6835_error_t nagi_mt6835_bus_queue_write(
+  nagi_mt6835_bus_t *pbus,
+  uint8_t device,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t data
+);
+
+/// @brief Run the next slot, call from a fixed rate timer.
+/// @note An empty config slot does no bus traffic, angle slots keep their timing either way.
+/// @param[in] pbus bus handle.
+/// @return mt6835 error code of the slot transaction.
+nagi_mt6835_error_t nagi_mt6835_bus_poll(nagi_mt6835_bus_t *pbus);
+
+/// @brief Run the remaining slots of the current cycle.
+/// @param[in] pbus bus handle.
+/// @return mt6835 error code, first angle read error of the cycle.
+nagi_mt6835_error_t nagi_mt6835_bus_poll_cycle(nagi_mt6835_bus_t *pbus);
+
+/// @brief Get the latest sample of a device.
+/// @param[in] pbus bus handle.
+/// @param[in] device device index.
+/// @param[out] psample sample.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_bus_get_sample(
+  const nagi_mt6835_bus_t *pbus,
+  uint8_t device,
+  nagi_mt6835_bus_sample_t *psample
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_BUS_H__
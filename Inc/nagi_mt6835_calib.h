@@ -0,0 +1,111 @@
+#ifndef __NAGI_MT6835_CALIB_H__
+#define __NAGI_MT6835_CALIB_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NAGI_MT6835_CALIB_SIZE_MIN      (256)
+#define NAGI_MT6835_CALIB_SIZE_MAX      (4096)
+#define NAGI_MT6835_CALIB_HARMONICS_MAX (16)
+
+/// @brief mt6835 nonlinearity calibration table.
+/// @note Entry n is the correction in raw counts at measured raw angle n * 2^21 / size, corrections
+///       in between are interpolated linearly. The mean is removed, the zero offset stays with
+///       @ref nagi_mt6835_set_zero_angle.
+typedef struct nagi_mt6835_calib_t {
+  /// @brief Corrections in raw counts, added to the raw angle.
+  int16_t *table;
+  /// @brief Table entries, power of two.
+  size_t size;
+  /// @brief Raw angle to table index shift, 21 - log2(size).
+  uint32_t shift;
+} nagi_mt6835_calib_t;
+
+/// @brief Initialize a calibration with an all zero table.
+/// @param[out] pcalib calibration.
+/// @param[in] table table storage, size entries, e.g. loaded from flash afterwards.
+/// @param[in] size table entries, power of two, NAGI_MT6835_CALIB_SIZE_MIN - NAGI_MT6835_CALIB_SIZE_MAX.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_calib_init(nagi_mt6835_calib_t *pcalib, int16_t *table, size_t size);
+
+/// @brief Build the reference angles of a constant speed sweep.
+/// @note Sample at a fixed rate over at least one whole turn, the speed is taken from the last
+///       whole turn and the offset from the mean over the whole turns.
+/// @param[in] measured measured raw angles.
+/// @param[in] count sample count, at least 2.
+/// @param[out] reference reference raw angles, count entries.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_calib_sweep_reference(
+  const uint32_t *measured,
+  size_t count,
+  uint32_t *reference
+);
+
+/// @brief Fit a piecewise linear correction, every entry is the mean error of its nearest samples.
+/// @note Entries without samples are interpolated from their neighbours.
+/// @param[in] pcalib calibration.
+/// @param[in] measured measured raw angles.
+/// @param[in] reference reference raw angles, from a reference encoder or
+///            @ref nagi_mt6835_calib_sweep_reference.
+/// @param[in] count sample count.
+/// @param[in] workspace 2 * size entries.
+/// @return mt6835 error code, NAGI_MT6835_INVALID_ARGUMENT if a correction exceeds int16_t.
+nagi_mt6835_error_t nagi_mt6835_calib_fit_linear(
+  nagi_mt6835_calib_t *pcalib,
+  const uint32_t *measured,
+  const uint32_t *reference,
+  size_t count,
+  int64_t *workspace
+);
+
+/// @brief Fit a correction from the first harmonics of the error, filters noise better.
+/// @note The samples must cover whole turns evenly, as a constant speed sweep does.
+/// @param[in] pcalib calibration.
+/// @param[in] measured measured raw angles.
+/// @param[in] reference reference raw angles.
+/// @param[in] count sample count.
+/// @param[in] harmonics harmonics to fit, 1 - NAGI_MT6835_CALIB_HARMONICS_MAX.
+/// @return mt6835 error code, NAGI_MT6835_INVALID_ARGUMENT if a correction exceeds int16_t.
+nagi_mt6835_error_t nagi_mt6835_calib_fit_harmonic(
+  nagi_mt6835_calib_t *pcalib,
+  const uint32_t *measured,
+  const uint32_t *reference,
+  size_t count,
+  size_t harmonics
+);
+
+/// @brief Run the calibration inside the angle getters of a mt6835 handle.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] pcalib calibration, NULL to detach.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_calib_attach(nagi_mt6835_t *pmt6835, const nagi_mt6835_calib_t *pcalib);
+
+/// @brief Correction function, @ref nagi_mt6835_angle_correct_fn_t.
+/// @param[in] ctx calibration.
+/// @param[in] raw_angle raw angle.
+/// @return corrected raw angle.
+uint32_t nagi_mt6835_calib_correct(void *ctx, uint32_t raw_angle);
+
+/// @brief Correct a raw angle, O(1), integer only, no checks.
+/// @param[in] pcalib calibration.
+/// @param[in] raw_angle raw angle.
+/// @return corrected raw angle.
+static inline uint32_t nagi_mt6835_calib_apply(const nagi_mt6835_calib_t *pcalib, uint32_t raw_angle) {
+  const uint32_t index = raw_angle >> pcalib->shift;
+  const uint32_t next = (index + 1) & (uint32_t)(pcalib->size - 1);
+  const int32_t frac = (int32_t)(raw_angle & ((1u << pcalib->shift) - 1));
+  const int32_t c0 = pcalib->table[index];
+  const int32_t c1 = pcalib->table[next];
+  const int32_t correction = c0 + (((c1 - c0) * frac) >> pcalib->shift);
+
+  return (raw_angle + (uint32_t)correction) & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_CALIB_H__
@@ -0,0 +1,184 @@
+#ifndef __NAGI_MT6835_CAPTURE_H__
+#define __NAGI_MT6835_CAPTURE_H__
+
+#include "nagi_mt6835.h"
+
+#if !defined(__cplusplus)
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Capture ring, records every angle sample at full rate for commissioning.
+///
+/// Records are kept in their stream format, so draining is a plain copy. A stream is one header
+/// followed by records back to back, all fields little endian:
+///
+/// header, 16 bytes
+///   0  uint32_t magic, "M6CP"
+///   4  uint8_t  version, 1
+///   5  uint8_t  record size, 8 or 12
+///   6  uint16_t reserved, 0
+///   8  uint32_t timestamp tick rate in Hz, 0 if unknown
+///   12 uint32_t reserved, 0
+///
+/// record, 8 bytes                      record, 12 bytes
+///   0 uint32_t timestamp                 0 uint64_t timestamp, extended past the 32 bit wrap
+///   4 uint32_t angle word                8 uint32_t angle word
+///
+/// angle word
+///   bit 0 - 20  raw angle
+///   bit 21 - 23 warning, @ref nagi_mt6835_warning_t
+///   bit 24      CRC ok
+///   bit 25 - 29 angle source, @ref nagi_mt6835_angle_flag_enum_t
+///   bit 31      samples were dropped before this one
+///
+/// One producer, the sample hook, and one consumer draining. A full ring drops new samples, counts
+/// them as overruns and marks the next stored record.
+
+#define NAGI_MT6835_CAPTURE_HEADER_SIZE (16)
+#define NAGI_MT6835_CAPTURE_MAGIC       (0x5043364Du)
+#define NAGI_MT6835_CAPTURE_VERSION     (1)
+
+#define NAGI_MT6835_CAPTURE_WORD_WARNING_SHIFT (21)
+#define NAGI_MT6835_CAPTURE_WORD_CRC_OK        (1u << 24)
+#define NAGI_MT6835_CAPTURE_WORD_FLAGS_SHIFT   (25)
+#define NAGI_MT6835_CAPTURE_WORD_GAP           (1u << 31)
+
+/// @brief Storage bytes for a ring of records.
+#define NAGI_MT6835_CAPTURE_STORAGE_SIZE(records, format) ((size_t)(records) * (size_t)(format))
+
+/// @brief mt6835 capture record format enum, the value is the record size.
+typedef enum nagi_mt6835_capture_format_enum_t {
+  NAGI_MT6835_CAPTURE_FORMAT_8 = 8, ///< 32 bit timestamp and angle word.
+  NAGI_MT6835_CAPTURE_FORMAT_12 = 12, ///< 64 bit timestamp and angle word.
+} nagi_mt6835_capture_format_enum_t;
+
+/// @brief mt6835 decoded capture record.
+typedef struct nagi_mt6835_capture_record_t {
+  /// @brief Timestamp, 32 bit wrapping for the 8 byte format.
+  uint64_t timestamp;
+  /// @brief Raw angle.
+  uint32_t raw_angle;
+  /// @brief Warning.
+  nagi_mt6835_warning_t warning;
+  /// @brief Sample passed the CRC check.
+  bool crc_ok;
+  /// @brief Angle source, @ref nagi_mt6835_angle_flag_enum_t.
+  uint8_t angle_flags;
+  /// @brief Samples were dropped before this one.
+  bool gap;
+} nagi_mt6835_capture_record_t;
+
+/// @brief mt6835 capture ring.
+typedef struct nagi_mt6835_capture_t {
+  /// @brief Record storage.
+  uint8_t *storage;
+  /// @brief Capacity in records, power of two.
+  uint32_t capacity;
+  /// @brief Record format.
+  nagi_mt6835_capture_format_enum_t format;
+  /// @brief Timestamp tick rate in Hz, for the stream header.
+  uint32_t timer_hz;
+  /// @brief Records written, free running, producer owned.
+  NAGI_MT6835_ATOMIC_U32 head;
+  /// @brief Records drained, free running, consumer owned.
+  NAGI_MT6835_ATOMIC_U32 tail;
+  /// @brief Dropped samples.
+  NAGI_MT6835_ATOMIC_U32 overruns;
+  /// @brief Next stored record follows dropped samples.
+  bool gap;
+  /// @brief Last timestamp, for the 64 bit extension.
+  uint32_t last_timestamp;
+  /// @brief Timestamp wraps.
+  uint32_t timestamp_hi;
+} nagi_mt6835_capture_t;
+
+/// @brief Initialize an empty capture ring.
+/// @param[out] pcapture capture ring.
+/// @param[in] storage record storage, @ref NAGI_MT6835_CAPTURE_STORAGE_SIZE.
+/// @param[in] storage_size storage bytes, a power of two number of records.
+/// @param[in] format record format.
+/// @param[in] timer_hz timestamp tick rate in Hz, 0 if unknown.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_capture_init(
+  nagi_mt6835_capture_t *pcapture,
+  uint8_t *storage,
+  size_t storage_size,
+  nagi_mt6835_capture_format_enum_t format,
+  uint32_t timer_hz
+);
+
+/// @brief Capture every angle sample of a mt6835 handle.
+/// @note Adds a sample hook, the other hooks of the handle stay.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] pcapture capture ring, NULL to detach every one of the handle.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when the sample hooks are full.
+nagi_mt6835_error_t nagi_mt6835_capture_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_capture_t *pcapture);
+
+/// @brief Store a sample, @ref nagi_mt6835_sample_fn_t.
+/// @note Single producer, no checks, constant time.
+/// @param[in] ctx capture ring.
+/// @param[in] psample sample.
+void nagi_mt6835_capture_push(void *ctx, const nagi_mt6835_sample_t *psample);
+
+/// @brief Get the number of records ready to drain.
+/// @param[in] pcapture capture ring.
+/// @return records.
+uint32_t nagi_mt6835_capture_count(nagi_mt6835_capture_t *pcapture);
+
+/// @brief Get the number of dropped samples since init.
+/// @param[in] pcapture capture ring.
+/// @return dropped samples.
+uint32_t nagi_mt6835_capture_get_overruns(nagi_mt6835_capture_t *pcapture);
+
+/// @brief Write the stream header.
+/// @param[in] pcapture capture ring.
+/// @param[out] data header, @ref NAGI_MT6835_CAPTURE_HEADER_SIZE bytes.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_capture_write_header(const nagi_mt6835_capture_t *pcapture, uint8_t *data);
+
+/// @brief Move the oldest records to a stream buffer, single consumer.
+/// @param[in] pcapture capture ring.
+/// @param[out] data stream buffer, whole records only.
+/// @param[in] size stream buffer bytes.
+/// @param[out] pwritten bytes written.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_capture_drain(
+  nagi_mt6835_capture_t *pcapture,
+  uint8_t *data,
+  size_t size,
+  size_t *pwritten
+);
+
+/// @brief Parse a stream header.
+/// @param[in] data stream.
+/// @param[in] size stream bytes.
+/// @param[out] pformat record format.
+/// @param[out] ptimer_hz timestamp tick rate in Hz, optional.
+/// @return mt6835 error code, NAGI_MT6835_INVALID_ARGUMENT if not a capture stream.
+nagi_mt6835_error_t nagi_mt6835_capture_parse_header(
+  const uint8_t *data,
+  size_t size,
+  nagi_mt6835_capture_format_enum_t *pformat,
+  uint32_t *ptimer_hz
+);
+
+/// @brief Decode one stream record.
+/// @param[in] data record.
+/// @param[in] format record format.
+/// @param[out] precord decoded record.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_capture_decode_record(
+  const uint8_t *data,
+  nagi_mt6835_capture_format_enum_t format,
+  nagi_mt6835_capture_record_t *precord
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_CAPTURE_H__
@@ -0,0 +1,132 @@
+#ifndef __NAGI_MT6835_CORO_HPP__
+#define __NAGI_MT6835_CORO_HPP__
+
+/// C++20 coroutine adapter over the mt6835 asynchronous request API, for host-side tools.
+///
+/// nagi::mt6835_async_result_t res = co_await nagi::mt6835_async_get_raw_angle(&mt6835);
+///
+/// The handle needs start_transfer_fn, and nagi_mt6835_async_transfer_done must be called when the
+/// transfer finishes. The awaiting coroutine is resumed from that call.
+
+#include <atomic>
+#include <coroutine>
+
+extern "C" {
+#include "nagi_mt6835.h"
+}
+
+namespace nagi {
+
+/// @brief mt6835 asynchronous operation result.
+struct mt6835_async_result_t {
+  /// @brief mt6835 error code.
+  nagi_mt6835_error_t err;
+  /// @brief Register data, for register read.
+  uint8_t data;
+  /// @brief Raw angle, for angle read.
+  uint32_t raw_angle;
+  /// @brief Warning, for angle read.
+  nagi_mt6835_warning_t warning;
+};
+
+/// @brief Awaitable mt6835 asynchronous request.
+class mt6835_async_op {
+public:
+  mt6835_async_op(
+    nagi_mt6835_t *pmt6835,
+    nagi_mt6835_async_op_enum_t op,
+    nagi_mt6835_reg_enum_t reg = NAGI_MT6835_REG_ID,
+    uint8_t data = 0
+  ) : pmt6835_(pmt6835) {
+    switch (op) {
+      case NAGI_MT6835_ASYNC_OP_GET_RAW_ANGLE:
+        prepare_err_ = nagi_mt6835_async_prepare_get_raw_angle(pmt6835, &req_);
+        break;
+      case NAGI_MT6835_ASYNC_OP_READ_REG:
+        prepare_err_ = nagi_mt6835_async_prepare_read_reg(pmt6835, &req_, reg);
+        break;
+      case NAGI_MT6835_ASYNC_OP_WRITE_REG:
+        prepare_err_ = nagi_mt6835_async_prepare_write_reg(pmt6835, &req_, reg, data);
+        break;
+      case NAGI_MT6835_ASYNC_OP_AUTO_ZERO:
+        prepare_err_ = nagi_mt6835_async_prepare_auto_zero_angle(pmt6835, &req_);
+        break;
+      case NAGI_MT6835_ASYNC_OP_PROGRAM_EEPROM:
+        prepare_err_ = nagi_mt6835_async_prepare_program_eeprom(pmt6835, &req_);
+        break;
+      default:
+        prepare_err_ = NAGI_MT6835_INVALID_ARGUMENT;
+        break;
+    }
+  }
+
+  mt6835_async_op(const mt6835_async_op &) = delete;
+  mt6835_async_op &operator=(const mt6835_async_op &) = delete;
+
+  bool await_ready() const noexcept { return prepare_err_ != NAGI_MT6835_OK; }
+
+  bool await_suspend(std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+    req_.done_fn = &mt6835_async_op::on_done;
+    req_.user_data = this;
+
+    nagi_mt6835_error_t err = nagi_mt6835_async_submit(pmt6835_, &req_);
+    if (err != NAGI_MT6835_OK && req_.state != NAGI_MT6835_ASYNC_STATE_DONE) {
+      // Rejected before queueing, nothing will complete it.
+      prepare_err_ = err;
+      return false;
+    }
+    // Whoever of submit and completion comes second resumes.
+    return !arrived_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  mt6835_async_result_t await_resume() const noexcept {
+    if (prepare_err_ != NAGI_MT6835_OK) {
+      return {prepare_err_, 0, 0, NAGI_MT6835_WARN_NONE};
+    }
+    return {req_.result, req_.data, req_.raw_angle, req_.warning};
+  }
+
+private:
+  static void on_done(nagi_mt6835_async_req_t *preq) {
+    auto *self = static_cast<mt6835_async_op *>(preq->user_data);
+    if (self->arrived_.exchange(true, std::memory_order_acq_rel)) {
+      self->continuation_.resume();
+    }
+  }
+
+  nagi_mt6835_t *pmt6835_;
+  nagi_mt6835_error_t prepare_err_ = NAGI_MT6835_OK;
+  nagi_mt6835_async_req_t req_{};
+  std::coroutine_handle<> continuation_{};
+  std::atomic<bool> arrived_{false};
+};
+
+/// @brief Await a raw angle read.
+inline mt6835_async_op mt6835_async_get_raw_angle(nagi_mt6835_t *pmt6835) {
+  return mt6835_async_op(pmt6835, NAGI_MT6835_ASYNC_OP_GET_RAW_ANGLE);
+}
+
+/// @brief Await a register read.
+inline mt6835_async_op mt6835_async_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg) {
+  return mt6835_async_op(pmt6835, NAGI_MT6835_ASYNC_OP_READ_REG, reg);
+}
+
+/// @brief Await a register write.
+inline mt6835_async_op mt6835_async_write_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t data) {
+  return mt6835_async_op(pmt6835, NAGI_MT6835_ASYNC_OP_WRITE_REG, reg, data);
+}
+
+/// @brief Await an auto zero.
+inline mt6835_async_op mt6835_async_auto_zero_angle(nagi_mt6835_t *pmt6835) {
+  return mt6835_async_op(pmt6835, NAGI_MT6835_ASYNC_OP_AUTO_ZERO);
+}
+
+/// @brief Await an EEPROM program.
+inline mt6835_async_op mt6835_async_program_eeprom(nagi_mt6835_t *pmt6835) {
+  return mt6835_async_op(pmt6835, NAGI_MT6835_ASYNC_OP_PROGRAM_EEPROM);
+}
+
+}  // namespace nagi
+
+#endif // __NAGI_MT6835_CORO_HPP__
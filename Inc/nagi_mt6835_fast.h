@@ -0,0 +1,75 @@
+#ifndef __NAGI_MT6835_FAST_H__
+#define __NAGI_MT6835_FAST_H__
+
+/// Statically configured angle read, for the sample path of a control loop.
+///
+/// CRC mode and transport are fixed per translation unit before the include:
+///
+///   #define NAGI_MT6835_FAST_CRC                           1
+///   #define NAGI_MT6835_FAST_CHIP_SELECT(ctx, select)      board_spi_cs(select)
+///   #define NAGI_MT6835_FAST_READ_WRITE(ctx, tx, rx, size) board_spi_transfer((tx), (rx), (size))
+///   #include "nagi_mt6835_fast.h"
+///
+/// There is no method to choose, a NORMAL read bursts ANGLE3 - CRC with the continuous read
+/// command, so both methods clock the same frame. The transport macros expand to direct calls, so
+/// the read is straight line code without the handle, function pointers or runtime branches on the
+/// configuration. NAGI_MT6835_FAST_READ_WRITE gets tx as a uint8_t * to a local copy of the frame,
+/// as on the generic path, so a transport without const tx compiles as is. Like
+/// @ref nagi_mt6835_continuous_read_decode it skips angle correction, recovery, statistics and the
+/// sample hook. Tools/nagi_mt6835_bench.c compares it with the generic path.
+
+#include "nagi_mt6835.h"
+
+#ifndef NAGI_MT6835_FAST_CRC
+#define NAGI_MT6835_FAST_CRC (1)
+#endif
+
+#if !defined(NAGI_MT6835_FAST_CHIP_SELECT) || !defined(NAGI_MT6835_FAST_READ_WRITE)
+#error "nagi_mt6835_fast.h needs NAGI_MT6835_FAST_CHIP_SELECT and NAGI_MT6835_FAST_READ_WRITE"
+#endif
+
+/// Continuous read frame size.
+#define NAGI_MT6835_FAST_FRAME_SIZE (NAGI_MT6835_FAST_CRC ? 6 : 5)
+
+/// @brief Read the raw angle with the static configuration, no checks.
+/// @param[in] ctx transport context, passed to the transport macros.
+/// @param[out] praw_angle raw angle, only set on success.
+/// @param[out] pwarning warning.
+/// @return mt6835 error code.
+static inline nagi_mt6835_error_t nagi_mt6835_fast_get_raw_angle(
+  void *ctx,
+  uint32_t *praw_angle,
+  nagi_mt6835_warning_t *pwarning
+) {
+  // A local frame, the transport may take a mutable tx buffer or use it as scratch.
+  uint8_t tx_buf[6] = NAGI_MT6835_CONTINUOUS_READ_TX_INIT;
+  uint8_t rx_buf[6];
+  (void)ctx;
+
+  NAGI_MT6835_FAST_CHIP_SELECT(ctx, true);
+  const int err = NAGI_MT6835_FAST_READ_WRITE(ctx, tx_buf, rx_buf, NAGI_MT6835_FAST_FRAME_SIZE);
+  NAGI_MT6835_FAST_CHIP_SELECT(ctx, false);
+  if (err != 0) {
+    return (nagi_mt6835_error_t)err;
+  }
+
+  return nagi_mt6835_continuous_read_decode(rx_buf, NAGI_MT6835_FAST_CRC, praw_angle, pwarning);
+}
+
+/// @brief Read the angle in the compile time unit NAGI_MT6835_ANGLE_UNIT, no checks.
+/// @param[in] ctx transport context, passed to the transport macros.
+/// @param[out] pangle angle, only set on success.
+/// @return mt6835 error code.
+static inline nagi_mt6835_error_t nagi_mt6835_fast_get_angle(void *ctx, nagi_mt6835_angle_t *pangle) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_warning_t warning = NAGI_MT6835_WARN_NONE;
+
+  const nagi_mt6835_error_t err = nagi_mt6835_fast_get_raw_angle(ctx, &raw_angle, &warning);
+  if (err == NAGI_MT6835_OK) {
+    *pangle = nagi_mt6835_raw_to_angle(raw_angle);
+  }
+
+  return err;
+}
+
+#endif // __NAGI_MT6835_FAST_H__
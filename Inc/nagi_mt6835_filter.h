@@ -0,0 +1,131 @@
+#ifndef __NAGI_MT6835_FILTER_H__
+#define __NAGI_MT6835_FILTER_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Sample conditioning for oversampled raw angles, e.g. several continuous reads per control period.
+///
+/// gate -> median -> average, each stage can be disabled:
+///
+/// gate:    a sample further than max_delta * (rejected run + 1) counts from the last accepted one,
+///          or a CRC failed or warned frame, is replaced by the last accepted sample.
+/// median:  median of the last median_size gated samples.
+/// average: mean of decimation median outputs, one output per decimation inputs.
+///
+/// All math is on signed 21-bit differences, so a window straddling 0 / 2^21 filters like any
+/// other. Per sample cost is bounded by NAGI_MT6835_FILTER_MEDIAN_MAX, no division except once per
+/// output, so it can run in the DMA ISR.
+
+/// Largest median window.
+#define NAGI_MT6835_FILTER_MEDIAN_MAX     (7)
+/// Largest decimation, keeps the average sum in int32_t.
+#define NAGI_MT6835_FILTER_DECIMATION_MAX (1024)
+
+/// @brief mt6835 filter configuration.
+typedef struct nagi_mt6835_filter_config_t {
+  /// @brief Median window, odd, 1 - NAGI_MT6835_FILTER_MEDIAN_MAX, 0 or 1 disables the median.
+  uint8_t median_size;
+  /// @brief Largest plausible per-sample move in counts, i.e. max speed * sample period, 0 disables the gate.
+  uint32_t max_delta;
+  /// @brief Consecutive rejected samples before the gate follows the input again, e.g. after a real
+  ///        jump, 0 for never.
+  uint16_t max_rejects;
+  /// @brief Inputs averaged per output, 1 - NAGI_MT6835_FILTER_DECIMATION_MAX, 0 or 1 disables the average.
+  uint16_t decimation;
+  /// @brief Treat frames with any warning bit as rejected, only for @ref nagi_mt6835_filter_push_frame.
+  bool reject_warnings;
+} nagi_mt6835_filter_config_t;
+
+/// @brief mt6835 filter.
+typedef struct nagi_mt6835_filter_t {
+  /// @brief Median window.
+  uint8_t median_size;
+  /// @brief Gate threshold in counts, 0 for no gate.
+  uint32_t max_delta;
+  /// @brief Rejected run that re-locks the gate, 0 for never.
+  uint16_t max_rejects;
+  /// @brief Inputs per output.
+  uint16_t decimation;
+  /// @brief Reject warned frames.
+  bool reject_warnings;
+
+  /// @brief First sample seen.
+  bool primed;
+  /// @brief Last accepted sample, the gate reference.
+  uint32_t last_accepted;
+  /// @brief Consecutive rejected samples.
+  uint16_t reject_run;
+  /// @brief Median window ring, gated samples.
+  uint32_t window[NAGI_MT6835_FILTER_MEDIAN_MAX];
+  /// @brief Next window slot.
+  uint8_t window_index;
+  /// @brief Last median output, the reference of the window differences.
+  uint32_t last_median;
+  /// @brief Average block reference, the first median output of the block.
+  uint32_t block_ref;
+  /// @brief Sum of the block differences to block_ref.
+  int32_t block_sum;
+  /// @brief Inputs in the block.
+  uint16_t block_count;
+
+  /// @brief Samples pushed.
+  uint32_t sample_count;
+  /// @brief Samples replaced by the gate, including invalid ones.
+  uint32_t reject_count;
+  /// @brief Invalid samples, CRC failed or warned frames.
+  uint32_t invalid_count;
+  /// @brief Times the gate re-locked after max_rejects.
+  uint32_t relock_count;
+} nagi_mt6835_filter_t;
+
+/// @brief Initialize a filter, the first sample primes every stage.
+/// @param[out] pfilter filter.
+/// @param[in] pconfig configuration.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_filter_init(nagi_mt6835_filter_t *pfilter, const nagi_mt6835_filter_config_t *pconfig);
+
+/// @brief Drop the filter history and counters, the next sample primes again.
+/// @param[in] pfilter filter.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_filter_reset(nagi_mt6835_filter_t *pfilter);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions are for the DMA ISR. Integer only, no checks.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Push a raw angle.
+/// @param[in] pfilter filter.
+/// @param[in] raw_angle raw angle.
+/// @param[out] praw_angle filtered raw angle, set when an output is ready.
+/// @return true when an output is ready, every decimation inputs.
+bool nagi_mt6835_filter_push(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle, uint32_t *praw_angle);
+
+/// @brief Push a sample without a valid angle, e.g. a CRC failed read. The gate holds the last
+///        accepted sample, so the output cadence is kept. Before the first valid sample it is dropped.
+/// @param[in] pfilter filter.
+/// @param[out] praw_angle filtered raw angle, set when an output is ready.
+/// @return true when an output is ready.
+bool nagi_mt6835_filter_push_invalid(nagi_mt6835_filter_t *pfilter, uint32_t *praw_angle);
+
+/// @brief Decode a continuous read rx frame and push it.
+/// @param[in] pfilter filter.
+/// @param[in] rx_data rx frame, 6 bytes with CRC check, 5 without.
+/// @param[in] check_crc check the CRC byte.
+/// @param[out] praw_angle filtered raw angle, set when an output is ready.
+/// @return true when an output is ready.
+bool nagi_mt6835_filter_push_frame(
+  nagi_mt6835_filter_t *pfilter,
+  const uint8_t *rx_data,
+  bool check_crc,
+  uint32_t *praw_angle
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_FILTER_H__
@@ -0,0 +1,158 @@
+#ifndef __NAGI_MT6835_HEALTH_H__
+#define __NAGI_MT6835_HEALTH_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Signal quality analytics, fed by the sample hook, for spotting a drifting magnet or a degrading
+/// cable before the warnings fire hard.
+///
+/// Per measured sample, with d the signed move since the previous sample:
+///
+/// jitter:   running variance of d, its mean is the speed in counts per sample.
+/// residual: r = d - previous d, the error of a linear extrapolation from the two previous samples.
+///           Zero at standstill or constant speed for a noiseless sensor, white angle noise of
+///           variance s^2 gives var(r) = 6 s^2, so noise = sqrt(var(r) / 6).
+/// rates:    samples with CRC failures, retried ones included, failed transfers and each warning bit.
+///
+/// Statistics are Welford accumulators, O(1) per sample. The window slides by blocks of
+/// block_samples samples, the last block_count full blocks plus the current one, merged on query.
+/// Memory is the caller's block storage, fixed at init. Samples that were not measured or follow a
+/// sequence gap restart the move history, they still count for the rates.
+
+/// @brief Storage bytes for a window of blocks.
+#define NAGI_MT6835_HEALTH_STORAGE_SIZE(blocks) ((size_t)(blocks) * sizeof(nagi_mt6835_health_block_t))
+
+/// @brief mt6835 health Welford accumulator.
+typedef struct nagi_mt6835_health_stat_t {
+  /// @brief Values.
+  uint32_t count;
+  /// @brief Mean.
+  float mean;
+  /// @brief Sum of squared differences to the mean.
+  float m2;
+} nagi_mt6835_health_stat_t;
+
+/// @brief mt6835 health block, the statistics of block_samples samples.
+typedef struct nagi_mt6835_health_block_t {
+  /// @brief Samples.
+  uint32_t samples;
+  /// @brief Samples with CRC failures.
+  uint32_t crc_errors;
+  /// @brief Samples with failed transfers.
+  uint32_t bus_errors;
+  /// @brief Samples with any warning.
+  uint32_t warnings;
+  /// @brief Samples with NAGI_MT6835_WARN_OVER_SPEED.
+  uint32_t over_speed;
+  /// @brief Samples with NAGI_MT6835_WARN_FIELD_WEAK.
+  uint32_t field_weak;
+  /// @brief Samples with NAGI_MT6835_WARN_UNDER_VOLTAGE.
+  uint32_t under_voltage;
+  /// @brief Sample to sample moves, counts.
+  nagi_mt6835_health_stat_t delta;
+  /// @brief Linear extrapolation residuals, counts.
+  nagi_mt6835_health_stat_t residual;
+} nagi_mt6835_health_block_t;
+
+/// @brief mt6835 health metrics over the window.
+typedef struct nagi_mt6835_health_metrics_t {
+  /// @brief Samples in the window.
+  uint32_t samples;
+  /// @brief Mean move, counts per sample.
+  float speed;
+  /// @brief Standard deviation of the move, counts.
+  float jitter;
+  /// @brief Residual variance, counts^2.
+  float residual_variance;
+  /// @brief Angle noise estimate, sqrt(residual_variance / 6), counts.
+  float noise;
+  /// @brief Share of samples with CRC failures, 0 - 1.
+  float crc_error_rate;
+  /// @brief Share of samples with failed transfers, 0 - 1.
+  float bus_error_rate;
+  /// @brief Share of samples with any warning, 0 - 1.
+  float warning_rate;
+  /// @brief Share of samples with NAGI_MT6835_WARN_OVER_SPEED, 0 - 1.
+  float over_speed_rate;
+  /// @brief Share of samples with NAGI_MT6835_WARN_FIELD_WEAK, 0 - 1.
+  float field_weak_rate;
+  /// @brief Share of samples with NAGI_MT6835_WARN_UNDER_VOLTAGE, 0 - 1.
+  float under_voltage_rate;
+} nagi_mt6835_health_metrics_t;
+
+/// @brief mt6835 signal quality analytics, one per handle.
+typedef struct nagi_mt6835_health_t {
+  /// @brief Full block ring.
+  nagi_mt6835_health_block_t *blocks;
+  /// @brief Blocks in the ring.
+  uint32_t block_count;
+  /// @brief Samples per block.
+  uint32_t block_samples;
+  /// @brief Next ring slot.
+  uint32_t block_index;
+  /// @brief Full blocks in the ring, up to block_count.
+  uint32_t block_fill;
+  /// @brief Block being filled.
+  nagi_mt6835_health_block_t current;
+
+  /// @brief Measured samples in a row, up to 2.
+  uint8_t history;
+  /// @brief Last measured raw angle.
+  uint32_t last_raw_angle;
+  /// @brief Last move.
+  int32_t last_delta;
+  /// @brief Sequence number expected next.
+  uint32_t next_seq;
+} nagi_mt6835_health_t;
+
+/// @brief Initialize the analytics with an empty window.
+/// @param[out] phealth analytics.
+/// @param[in] blocks block storage, @ref NAGI_MT6835_HEALTH_STORAGE_SIZE.
+/// @param[in] block_count blocks in the storage, at least 1.
+/// @param[in] block_samples samples per block, at least 1.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_health_init(
+  nagi_mt6835_health_t *phealth,
+  nagi_mt6835_health_block_t *blocks,
+  uint32_t block_count,
+  uint32_t block_samples
+);
+
+/// @brief Empty the window, e.g. when the motor leaves standstill or constant speed.
+/// @param[in] phealth analytics.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_health_reset(nagi_mt6835_health_t *phealth);
+
+/// @brief Analyse every angle sample of a mt6835 handle.
+/// @note Adds a sample hook, the other hooks of the handle stay.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] phealth analytics, NULL to detach every one of the handle.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when the sample hooks are full.
+nagi_mt6835_error_t nagi_mt6835_health_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_health_t *phealth);
+
+/// @brief Add a sample, @ref nagi_mt6835_sample_fn_t.
+/// @note Single producer, no checks, constant time.
+/// @param[in] ctx analytics.
+/// @param[in] psample sample.
+void nagi_mt6835_health_push(void *ctx, const nagi_mt6835_sample_t *psample);
+
+/// @brief Get the metrics over the window.
+/// @note Merges block_count + 1 blocks, call it from the main loop with the sample hook masked,
+///       e.g. the DMA interrupt disabled, not from the ISR.
+/// @param[in] phealth analytics.
+/// @param[out] pmetrics metrics, all 0 for an empty window.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_health_get(
+  const nagi_mt6835_health_t *phealth,
+  nagi_mt6835_health_metrics_t *pmetrics
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_HEALTH_H__
@@ -0,0 +1,113 @@
+#ifndef __NAGI_MT6835_MULTITURN_H__
+#define __NAGI_MT6835_MULTITURN_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NAGI_MT6835_MULTITURN_HALF_TURN (NAGI_MT6835_ANGLE_RESOLUTION / 2)
+
+/// @brief mt6835 multi-turn tracker.
+typedef struct nagi_mt6835_multiturn_t {
+  /// @brief Accumulated position in raw counts, NAGI_MT6835_ANGLE_RESOLUTION counts per turn.
+  int64_t position;
+  /// @brief Last raw angle.
+  uint32_t last_raw_angle;
+  /// @brief Largest plausible per-sample move in counts, larger moves count as aliased.
+  uint32_t max_delta;
+  /// @brief Aliased samples since init.
+  uint32_t alias_count;
+} nagi_mt6835_multiturn_t;
+
+/// @brief Initialize the tracker at turn 0.
+/// @param[out] ptracker tracker.
+/// @param[in] raw_angle first raw angle.
+/// @param[in] max_delta largest plausible per-sample move in counts, i.e. max speed * sample period,
+///            0 or anything above half a turn means half a turn.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_multiturn_init(
+  nagi_mt6835_multiturn_t *ptracker,
+  uint32_t raw_angle,
+  uint32_t max_delta
+);
+
+/// @brief Restore a saved position after power up.
+/// @note The shaft may have moved by less than half a turn while unpowered, the turn count is
+///       picked so that the new position is the one closest to the saved one.
+/// @param[out] ptracker tracker.
+/// @param[in] saved_position position from @ref nagi_mt6835_multiturn_get_position.
+/// @param[in] raw_angle first raw angle after power up.
+/// @param[in] max_delta see @ref nagi_mt6835_multiturn_init.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_multiturn_restore(
+  nagi_mt6835_multiturn_t *ptracker,
+  int64_t saved_position,
+  uint32_t raw_angle,
+  uint32_t max_delta
+);
+
+/// @brief Read the angle from the mt6835 and update the tracker.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[in] ptracker tracker.
+/// @param[out] paliased sample aliased, NULL if not needed.
+/// @return mt6835 error code, the tracker is not updated on error.
+nagi_mt6835_error_t nagi_mt6835_multiturn_read(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  nagi_mt6835_multiturn_t *ptracker,
+  bool *paliased
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions are for the FOC ISR. Integer only, no branches, no checks.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Signed shortest move between two raw angles.
+/// @param[in] raw_angle raw angle.
+/// @param[in] last_raw_angle previous raw angle.
+/// @return move in counts, -half turn to half turn - 1.
+static inline int32_t nagi_mt6835_multiturn_delta(uint32_t raw_angle, uint32_t last_raw_angle) {
+  // Sign extend the 21-bit difference.
+  return (int32_t)((raw_angle - last_raw_angle) << 11) >> 11;
+}
+
+/// @brief Update the tracker with a new raw angle.
+/// @param[in] ptracker tracker.
+/// @param[in] raw_angle raw angle, from @ref nagi_mt6835_get_raw_angle or a continuous read.
+/// @return true if the move exceeded max_delta, the position still takes the shortest move.
+static inline bool nagi_mt6835_multiturn_update(nagi_mt6835_multiturn_t *ptracker, uint32_t raw_angle) {
+  const int32_t delta = nagi_mt6835_multiturn_delta(raw_angle, ptracker->last_raw_angle);
+  const int32_t sign = delta >> 31;
+  const uint32_t magnitude = (uint32_t)((delta ^ sign) - sign);
+  const bool aliased = magnitude > ptracker->max_delta;
+
+  ptracker->position += delta;
+  ptracker->last_raw_angle = raw_angle;
+  ptracker->alias_count += aliased;
+
+  return aliased;
+}
+
+/// @brief Get the accumulated position.
+/// @param[in] ptracker tracker.
+/// @return position in raw counts.
+static inline int64_t nagi_mt6835_multiturn_get_position(const nagi_mt6835_multiturn_t *ptracker) {
+  return ptracker->position;
+}
+
+/// @brief Get the full turns, rounded towards minus infinity.
+/// @param[in] ptracker tracker.
+/// @return turns.
+static inline int64_t nagi_mt6835_multiturn_get_turns(const nagi_mt6835_multiturn_t *ptracker) {
+  // Arithmetic shift, floors negative positions.
+  return ptracker->position >> 21;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_MULTITURN_H__
@@ -0,0 +1,181 @@
+#ifndef __NAGI_MT6835_OBSERVER_H__
+#define __NAGI_MT6835_OBSERVER_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Angle tracking observers, a third order tracking loop with all poles at -2 * pi * bandwidth.
+///
+/// predict: angle += velocity * dt + acceleration * dt^2 / 2, velocity += acceleration * dt
+/// correct: e = measured - angle, angle += k1 e, velocity += k2 e, acceleration += k3 e
+///
+/// with k1 = 3 w dt, k2 = 3 w^2 dt, k3 = w^3 dt. Angles are kept as uint32_t Q32 turns, so they
+/// wrap at one turn for free and the angle error is a plain int32_t subtraction.
+///
+/// The float variant integrates the measured time between samples. The fixed point variant runs at
+/// the configured sample rate, e.g. from the FOC ISR, its timestamps only place the estimate in
+/// time for extrapolation.
+
+/// @brief mt6835 observer configuration.
+typedef struct nagi_mt6835_observer_config_t {
+  /// @brief Loop bandwidth in Hz, below sample_hz / (6 * pi).
+  float bandwidth_hz;
+  /// @brief Timestamp tick rate in Hz.
+  uint32_t timer_hz;
+  /// @brief Nominal sample rate in Hz, at most timer_hz.
+  uint32_t sample_hz;
+} nagi_mt6835_observer_config_t;
+
+/// @brief mt6835 float observer.
+typedef struct nagi_mt6835_observer_f32_t {
+  /// @brief Angle, Q32 turns.
+  uint32_t angle;
+  /// @brief Velocity in rad/s.
+  float velocity;
+  /// @brief Acceleration in rad/s^2.
+  float acceleration;
+  /// @brief Timestamp of the last sample.
+  uint32_t timestamp;
+  /// @brief Seconds per timestamp tick.
+  float tick_s;
+  /// @brief Longest dt used for the gains, keeps the loop stable over dropped samples.
+  float max_gain_dt;
+  /// @brief Gain 1, 3 w.
+  float k1;
+  /// @brief Gain 2, 3 w^2.
+  float k2;
+  /// @brief Gain 3, w^3.
+  float k3;
+} nagi_mt6835_observer_f32_t;
+
+/// @brief mt6835 fixed point observer.
+typedef struct nagi_mt6835_observer_q32_t {
+  /// @brief Angle, Q32 turns.
+  uint32_t angle;
+  /// @brief Velocity, Q48 turns per sample.
+  int64_t velocity;
+  /// @brief Acceleration, Q48 turns per sample^2.
+  int64_t acceleration;
+  /// @brief Timestamp of the last sample.
+  uint32_t timestamp;
+  /// @brief Samples per timestamp tick, Q32.
+  uint64_t samples_per_tick;
+  /// @brief Sample rate in Hz.
+  uint32_t sample_hz;
+  /// @brief Gain 1, Q32.
+  uint32_t k1;
+  /// @brief Gain 2, Q32.
+  uint32_t k2;
+  /// @brief Gain 3, Q32.
+  uint32_t k3;
+} nagi_mt6835_observer_q32_t;
+
+/// @brief Initialize the float observer at rest on the first sample.
+/// @param[out] pobserver observer.
+/// @param[in] pconfig configuration.
+/// @param[in] raw_angle first raw angle.
+/// @param[in] timestamp first sample time in ticks.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_f32_init(
+  nagi_mt6835_observer_f32_t *pobserver,
+  const nagi_mt6835_observer_config_t *pconfig,
+  uint32_t raw_angle,
+  uint32_t timestamp
+);
+
+/// @brief Update the float observer with a new sample.
+/// @param[in] pobserver observer.
+/// @param[in] raw_angle raw angle.
+/// @param[in] timestamp sample time in ticks.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_f32_update(
+  nagi_mt6835_observer_f32_t *pobserver,
+  uint32_t raw_angle,
+  uint32_t timestamp
+);
+
+/// @brief Extrapolate the float observer angle.
+/// @param[in] pobserver observer.
+/// @param[in] target_time time in ticks, e.g. the next PWM update.
+/// @param[out] pangle angle in rad, 0 - 2 pi.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_f32_extrapolate(
+  const nagi_mt6835_observer_f32_t *pobserver,
+  uint32_t target_time,
+  float *pangle
+);
+
+/// @brief Get the float observer angle at the last sample.
+/// @param[in] pobserver observer.
+/// @return angle in rad, 0 - 2 pi.
+float nagi_mt6835_observer_f32_get_angle(const nagi_mt6835_observer_f32_t *pobserver);
+
+/// @brief Initialize the fixed point observer at rest on the first sample.
+/// @param[out] pobserver observer.
+/// @param[in] pconfig configuration.
+/// @param[in] raw_angle first raw angle.
+/// @param[in] timestamp first sample time in ticks.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_q32_init(
+  nagi_mt6835_observer_q32_t *pobserver,
+  const nagi_mt6835_observer_config_t *pconfig,
+  uint32_t raw_angle,
+  uint32_t timestamp
+);
+
+/// @brief Update the fixed point observer with a new sample, integer only.
+/// @note Call once per sample period, dt is taken as 1 / sample_hz.
+/// @param[in] pobserver observer.
+/// @param[in] raw_angle raw angle.
+/// @param[in] timestamp sample time in ticks.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_q32_update(
+  nagi_mt6835_observer_q32_t *pobserver,
+  uint32_t raw_angle,
+  uint32_t timestamp
+);
+
+/// @brief Extrapolate the fixed point observer angle, integer only.
+/// @note Meant for a few sample periods ahead.
+/// @param[in] pobserver observer.
+/// @param[in] target_time time in ticks, e.g. the next PWM update.
+/// @param[out] pangle angle, Q32 turns, >> 11 for raw counts.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_observer_q32_extrapolate(
+  const nagi_mt6835_observer_q32_t *pobserver,
+  uint32_t target_time,
+  uint32_t *pangle
+);
+
+/// @brief Get the fixed point observer velocity.
+/// @param[in] pobserver observer.
+/// @return velocity, Q16 turns/s.
+int64_t nagi_mt6835_observer_q32_get_velocity(const nagi_mt6835_observer_q32_t *pobserver);
+
+/// @brief Get the fixed point observer acceleration.
+/// @param[in] pobserver observer.
+/// @return acceleration, Q16 turns/s^2.
+int64_t nagi_mt6835_observer_q32_get_acceleration(const nagi_mt6835_observer_q32_t *pobserver);
+
+/// @brief Prediction function for the CRC failure fallback, @ref nagi_mt6835_angle_predict_fn_t.
+/// @note Timestamp the observer samples with the handle cycle counter.
+/// @param[in] ctx float observer.
+/// @param[in] timestamp cycle counter.
+/// @return predicted raw angle.
+uint32_t nagi_mt6835_observer_f32_predict(void *ctx, uint32_t timestamp);
+
+/// @brief Prediction function for the CRC failure fallback, @ref nagi_mt6835_angle_predict_fn_t.
+/// @note Timestamp the observer samples with the handle cycle counter.
+/// @param[in] ctx fixed point observer.
+/// @param[in] timestamp cycle counter.
+/// @return predicted raw angle.
+uint32_t nagi_mt6835_observer_q32_predict(void *ctx, uint32_t timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_OBSERVER_H__
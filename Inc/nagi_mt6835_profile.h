@@ -0,0 +1,103 @@
+#ifndef __NAGI_MT6835_PROFILE_H__
+#define __NAGI_MT6835_PROFILE_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief mt6835 profile field enum, select which fields of a profile are applied.
+typedef enum nagi_mt6835_profile_field_t {
+  NAGI_MT6835_PROFILE_FIELD_ID = 0x0001, ///< Custom ID.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_OUTPUT = 0x0002, ///< ABZ output enable.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_AB_SWAP = 0x0004, ///< ABZ AB swap.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_RESOLUTION = 0x0008, ///< ABZ resolution.
+  NAGI_MT6835_PROFILE_FIELD_ZERO_POSITION = 0x0010, ///< Zero / ABZ z position.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_Z_EDGE = 0x0020, ///< ABZ z edge.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_Z_PULSE_WIDTH = 0x0040, ///< ABZ z pulse width.
+  NAGI_MT6835_PROFILE_FIELD_ABZ_Z_PHASE = 0x0080, ///< ABZ z phase.
+  NAGI_MT6835_PROFILE_FIELD_UVW = 0x0100, ///< UVW register bits [5:0].
+  NAGI_MT6835_PROFILE_FIELD_PWM = 0x0200, ///< PWM register.
+  NAGI_MT6835_PROFILE_FIELD_HYST = 0x0400, ///< HYST register.
+  NAGI_MT6835_PROFILE_FIELD_ALL = 0x07FF, ///< All fields.
+} nagi_mt6835_profile_field_t;
+
+/// @brief mt6835 configuration profile.
+typedef struct nagi_mt6835_profile_t {
+  /// @brief Fields to apply, mask of @ref nagi_mt6835_profile_field_t.
+  uint32_t fields;
+  /// @brief Custom ID.
+  uint8_t id;
+  /// @brief ABZ output enable.
+  bool abz_output_enable;
+  /// @brief ABZ AB swap.
+  bool abz_ab_swap;
+  /// @brief ABZ resolution(0 - 0x3FFF).
+  uint16_t abz_resolution;
+  /// @brief Zero / ABZ z position(0x000 = 0, 0x001 = 0.088, ... 0xFFF = 359.912).
+  uint16_t zero_position;
+  /// @brief ABZ z edge up.
+  bool abz_z_edge_up;
+  /// @brief ABZ z pulse width(0x0 - 0x7), see @ref nagi_mt6835_set_abz_z_pulse_width.
+  uint8_t abz_z_pulse_width;
+  /// @brief ABZ z phase(0x0 - 0x3), see @ref nagi_mt6835_set_abz_z_phase.
+  uint8_t abz_z_phase;
+  /// @brief UVW register bits [5:0], bits [7:6] are the ABZ z phase.
+  uint8_t uvw;
+  /// @brief PWM register.
+  uint8_t pwm;
+  /// @brief HYST register.
+  uint8_t hyst;
+} nagi_mt6835_profile_t;
+
+/// @brief mt6835 profile apply result.
+typedef struct nagi_mt6835_profile_result_t {
+  /// @brief Written registers, bit n for register n.
+  uint16_t written_mask;
+  /// @brief Number of register writes.
+  uint8_t write_count;
+  /// @brief EEPROM was programmed.
+  bool eeprom_programmed;
+} nagi_mt6835_profile_result_t;
+
+/// @brief Check profile field ranges.
+/// @param[in] pprofile profile.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_profile_validate(const nagi_mt6835_profile_t *pprofile);
+
+/// @brief Build the register image of a profile on top of the current registers.
+/// @param[in] pprofile profile.
+/// @param[in] cur_regs current registers 0x001 - 0x00E, @ref NAGI_MT6835_SHADOW_REG_COUNT bytes.
+/// @param[out] target_regs target registers 0x001 - 0x00E, @ref NAGI_MT6835_SHADOW_REG_COUNT bytes.
+/// @param[out] pdiff_mask registers that differ, bit n for register n.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_profile_build(
+  const nagi_mt6835_profile_t *pprofile,
+  const uint8_t *cur_regs,
+  uint8_t *target_regs,
+  uint16_t *pdiff_mask
+);
+
+/// @brief Apply a profile with the minimal set of register writes.
+/// @note Reads the device once, writes only the registers that differ and programs the EEPROM
+///       only when something was written. Skipping the program assumes the registers reflect the
+///       EEPROM, i.e. nothing was changed without programming since power up. The shadow cache
+///       is left as it was, a valid one follows the writes.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] pprofile profile.
+/// @param[in] program_eeprom program EEPROM when registers changed.
+/// @param[out] presult apply result, may be NULL.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_profile_apply(
+  nagi_mt6835_t *pmt6835,
+  const nagi_mt6835_profile_t *pprofile,
+  bool program_eeprom,
+  nagi_mt6835_profile_result_t *presult
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_PROFILE_H__
@@ -0,0 +1,61 @@
+#ifndef __NAGI_MT6835_PUB_H__
+#define __NAGI_MT6835_PUB_H__
+
+#include "nagi_mt6835.h"
+
+#if !defined(__cplusplus)
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Lock free sample publication, one writer and any number of readers, e.g. the SPI DMA ISR
+/// writing and the current loop, the speed loop and a telemetry task reading.
+///
+/// Two copies of the sample behind a sequence counter. The writer bumps the counter to odd, which
+/// points the readers at copy 1, and rewrites copy 0, then bumps it to even and rewrites copy 1.
+/// A reader picks the copy the counter points at and retries only when the counter moved while it
+/// was copying. A reader interrupting the writer never waits, the copy it reads is never the one
+/// being written.
+
+#define NAGI_MT6835_PUB_WORDS (3)
+
+/// @brief mt6835 sample publication.
+typedef struct nagi_mt6835_pub_t {
+  /// @brief Sequence counter, twice the published samples, odd while copy 0 is rewritten.
+  NAGI_MT6835_ATOMIC_U32 latch;
+  /// @brief Sample copies, packed angle word, timestamp and sequence number.
+  NAGI_MT6835_ATOMIC_U32 copies[2][NAGI_MT6835_PUB_WORDS];
+} nagi_mt6835_pub_t;
+
+/// @brief Initialize a publication with no sample.
+/// @param[out] ppub publication.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_pub_init(nagi_mt6835_pub_t *ppub);
+
+/// @brief Publish every angle sample of a mt6835 handle.
+/// @note Adds a sample hook, the other hooks of the handle stay.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] ppub publication, NULL to detach every one of the handle.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when the sample hooks are full.
+nagi_mt6835_error_t nagi_mt6835_pub_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_pub_t *ppub);
+
+/// @brief Publish a sample, @ref nagi_mt6835_sample_fn_t.
+/// @note Single writer, no checks.
+/// @param[in] ctx publication.
+/// @param[in] psample sample.
+void nagi_mt6835_pub_publish(void *ctx, const nagi_mt6835_sample_t *psample);
+
+/// @brief Read a consistent copy of the latest sample, from any thread or interrupt.
+/// @param[in] ppub publication.
+/// @param[out] psample sample.
+/// @return mt6835 error code, NAGI_MT6835_ERROR before the first sample.
+nagi_mt6835_error_t nagi_mt6835_pub_read(nagi_mt6835_pub_t *ppub, nagi_mt6835_sample_t *psample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_PUB_H__
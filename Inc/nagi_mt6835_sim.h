@@ -0,0 +1,183 @@
+#ifndef __NAGI_MT6835_SIM_H__
+#define __NAGI_MT6835_SIM_H__
+
+#include "nagi_mt6835.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NAGI_MT6835_SIM_REG_COUNT (0x010)
+#define NAGI_MT6835_SIM_CMD_COUNT (16)
+
+/// @brief mt6835 simulator angle trajectory enum.
+typedef enum nagi_mt6835_sim_trajectory_enum_t {
+  NAGI_MT6835_SIM_TRAJECTORY_CONSTANT = 0, ///< Hold start angle.
+  NAGI_MT6835_SIM_TRAJECTORY_VELOCITY = 1, ///< Constant velocity in raw counts per sample.
+  NAGI_MT6835_SIM_TRAJECTORY_CUSTOM = 2, ///< User angle function.
+} nagi_mt6835_sim_trajectory_enum_t;
+
+/// @brief mt6835 simulator custom angle function typedef.
+/// @note Takes the user context and the sample index, returns the mechanical raw angle.
+typedef uint32_t (*nagi_mt6835_sim_angle_fn_t)(void *, uint32_t);
+
+/// @brief mt6835 simulator angle trajectory.
+typedef struct nagi_mt6835_sim_trajectory_t {
+  /// @brief Trajectory type.
+  nagi_mt6835_sim_trajectory_enum_t type;
+  /// @brief Mechanical raw angle at sample 0.
+  uint32_t start_angle;
+  /// @brief Raw counts added per sample, for velocity trajectory.
+  int32_t velocity;
+  /// @brief Angle function, for custom trajectory.
+  nagi_mt6835_sim_angle_fn_t angle_fn;
+  /// @brief Angle function user context.
+  void *angle_fn_ctx;
+} nagi_mt6835_sim_trajectory_t;
+
+/// @brief mt6835 simulator bus statistics.
+typedef struct nagi_mt6835_sim_stats_t {
+  /// @brief Chip select asserted transactions.
+  uint32_t transactions;
+  /// @brief Bytes clocked on the bus.
+  uint32_t bytes;
+  /// @brief Calls to the read write function.
+  uint32_t read_write_calls;
+  /// @brief Transactions per command, indexed by @ref nagi_mt6835_cmd_enum_t.
+  uint32_t cmd_count[NAGI_MT6835_SIM_CMD_COUNT];
+  /// @brief Angle samples latched.
+  uint32_t samples;
+  /// @brief EEPROM program cycles.
+  uint32_t eeprom_programs;
+} nagi_mt6835_sim_stats_t;
+
+/// @brief mt6835 simulator structure.
+typedef struct nagi_mt6835_sim_t {
+  /// @brief Register file.
+  uint8_t regs[NAGI_MT6835_SIM_REG_COUNT];
+  /// @brief EEPROM image, loaded into the register file on power cycle.
+  uint8_t eeprom[NAGI_MT6835_SIM_REG_COUNT];
+  /// @brief Angle trajectory.
+  nagi_mt6835_sim_trajectory_t trajectory;
+  /// @brief Next sample index.
+  uint32_t tick;
+  /// @brief Last latched mechanical angle.
+  uint32_t mech_angle;
+  /// @brief Warning bits reported with each sample.
+  nagi_mt6835_warning_t warning;
+  /// @brief Number of upcoming samples reported with a corrupted CRC.
+  uint32_t crc_error_count;
+
+  /// @brief Chip select asserted.
+  bool cs;
+  /// @brief Byte position in current transaction.
+  size_t frame_pos;
+  /// @brief Command of current transaction.
+  uint8_t frame_cmd;
+  /// @brief Register address of current transaction.
+  uint16_t frame_reg;
+
+  /// @brief Bus statistics.
+  nagi_mt6835_sim_stats_t stats;
+} nagi_mt6835_sim_t;
+
+/// @brief Initialize the mt6835 simulator, all registers and EEPROM cleared.
+/// @param[in] psim simulator handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_init(nagi_mt6835_sim_t *psim);
+
+/// @brief Set simulator angle trajectory, restarts at sample 0.
+/// @param[in] psim simulator handle.
+/// @param[in] ptrajectory trajectory.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_set_trajectory(
+  nagi_mt6835_sim_t *psim,
+  const nagi_mt6835_sim_trajectory_t *ptrajectory
+);
+
+/// @brief Set simulator warning bits.
+/// @param[in] psim simulator handle.
+/// @param[in] warning warning bits, @ref nagi_mt6835_warning_t.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_set_warning(nagi_mt6835_sim_t *psim, nagi_mt6835_warning_t warning);
+
+/// @brief Corrupt the CRC of the next samples.
+/// @param[in] psim simulator handle.
+/// @param[in] count number of samples.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_inject_crc_errors(nagi_mt6835_sim_t *psim, uint32_t count);
+
+/// @brief Reload the register file from EEPROM.
+/// @param[in] psim simulator handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_power_cycle(nagi_mt6835_sim_t *psim);
+
+/// @brief Get simulator bus statistics.
+/// @param[in] psim simulator handle.
+/// @param[out] pstats statistics.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_get_stats(const nagi_mt6835_sim_t *psim, nagi_mt6835_sim_stats_t *pstats);
+
+/// @brief Reset simulator bus statistics.
+/// @param[in] psim simulator handle.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_reset_stats(nagi_mt6835_sim_t *psim);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Below functions plug the simulator into @ref nagi_mt6835_config_t.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Bind the simulator used by the callbacks below.
+/// @param[in] psim simulator handle, NULL to unbind.
+void nagi_mt6835_sim_bind(nagi_mt6835_sim_t *psim);
+
+/// @brief Fill a mt6835 configuration with the simulator callbacks.
+/// @param[out] pconfig mt6835 configuration.
+/// @param[in] enable_crc_check enable CRC check.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_make_config(nagi_mt6835_config_t *pconfig, bool enable_crc_check);
+
+/// @brief Fill a mt6835 configuration with the context simulator callbacks, no binding needed.
+/// @param[in] psim simulator handle.
+/// @param[out] pconfig mt6835 configuration.
+/// @param[in] enable_crc_check enable CRC check.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_sim_make_ctx_config(
+  nagi_mt6835_sim_t *psim,
+  nagi_mt6835_config_t *pconfig,
+  bool enable_crc_check
+);
+
+/// @brief Simulator chip select, @ref nagi_mt6835_chip_select_fn_t.
+/// @param[in] select chip select asserted.
+void nagi_mt6835_sim_chip_select(bool select);
+
+/// @brief Simulator read write, @ref nagi_mt6835_read_write_fn_t.
+/// @param[in] tx_data tx data.
+/// @param[out] rx_data rx data.
+/// @param[in] size transfer size.
+/// @return mt6835 error code.
+int nagi_mt6835_sim_read_write(uint8_t *tx_data, uint8_t *rx_data, size_t size);
+
+/// @brief Simulator chip select, @ref nagi_mt6835_chip_select_ctx_fn_t.
+/// @param[in] ctx simulator handle.
+/// @param[in] select chip select asserted.
+void nagi_mt6835_sim_chip_select_ctx(void *ctx, bool select);
+
+/// @brief Simulator read write, @ref nagi_mt6835_read_write_ctx_fn_t.
+/// @param[in] ctx simulator handle.
+/// @param[in] tx_data tx data.
+/// @param[out] rx_data rx data.
+/// @param[in] size transfer size.
+/// @return mt6835 error code.
+int nagi_mt6835_sim_read_write_ctx(void *ctx, uint8_t *tx_data, uint8_t *rx_data, size_t size);
+
+/// @brief Simulator delay, @ref nagi_mt6835_delay_fn_t.
+/// @param[in] ms delay in ms.
+void nagi_mt6835_sim_delay(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NAGI_MT6835_SIM_H__
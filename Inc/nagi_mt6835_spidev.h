@@ -0,0 +1,145 @@
+#ifndef __NAGI_MT6835_SPIDEV_H__
+#define __NAGI_MT6835_SPIDEV_H__
+
+#include "nagi_mt6835.h"
+#include "nagi_mt6835_profile.h"
+
+#if defined(__linux__)
+
+#include <linux/spi/spidev.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Transactions per SPI_IOC_MESSAGE, far below the spidev bufsiz limit of 4096 bytes.
+#define NAGI_MT6835_SPIDEV_BATCH_MAX (32)
+
+/// @brief mt6835 spidev ioctl function typedef.
+/// @note Takes the user context, the fd, the request and its argument, returns as ioctl(2).
+typedef int (*nagi_mt6835_spidev_ioctl_fn_t)(void *, int, unsigned long, void *);
+
+/// @brief mt6835 spidev configuration.
+typedef struct nagi_mt6835_spidev_config_t {
+  /// @brief Opened spidev node, one node per chip select.
+  int fd;
+  /// @brief SPI clock in Hz.
+  uint32_t speed_hz;
+  /// @brief ioctl function, NULL for ioctl(2), e.g. @ref nagi_mt6835_spidev_sim_ioctl in tests.
+  nagi_mt6835_spidev_ioctl_fn_t ioctl_fn;
+  /// @brief ioctl function user context.
+  void *ioctl_ctx;
+} nagi_mt6835_spidev_config_t;
+
+/// @brief mt6835 spidev transport, one per spidev node.
+/// @note Transactions queued with @ref nagi_mt6835_spidev_queue go out in one SPI_IOC_MESSAGE,
+///       the chip select is released between them with cs_change.
+typedef struct nagi_mt6835_spidev_t {
+  /// @brief Opened spidev node.
+  int fd;
+  /// @brief SPI clock in Hz.
+  uint32_t speed_hz;
+  /// @brief ioctl function.
+  nagi_mt6835_spidev_ioctl_fn_t ioctl_fn;
+  /// @brief ioctl function user context.
+  void *ioctl_ctx;
+
+  /// @brief Transfers of the queued transactions.
+  struct spi_ioc_transfer transfers[NAGI_MT6835_SPIDEV_BATCH_MAX];
+  /// @brief Queued requests.
+  nagi_mt6835_async_req_t *reqs[NAGI_MT6835_SPIDEV_BATCH_MAX];
+  /// @brief Handle of every queued request.
+  nagi_mt6835_t *devices[NAGI_MT6835_SPIDEV_BATCH_MAX];
+  /// @brief Queued transaction count.
+  size_t count;
+
+  /// @brief ioctl calls issued, for syscall accounting.
+  uint32_t ioctl_calls;
+} nagi_mt6835_spidev_t;
+
+/// @brief Initialize a spidev transport, sets SPI mode 3, 8 bit words and the clock.
+/// @param[out] pspidev spidev transport.
+/// @param[in] pconfig configuration.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_spidev_init(nagi_mt6835_spidev_t *pspidev, const nagi_mt6835_spidev_config_t *pconfig);
+
+/// @brief Fill a driver configuration for a device on the spidev node.
+/// @note Blocking calls take one ioctl per transaction, the kernel drives the chip select.
+/// @param[in] pspidev spidev transport.
+/// @param[out] pconfig driver configuration.
+/// @param[in] enable_crc_check enable CRC check.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_spidev_make_config(
+  nagi_mt6835_spidev_t *pspidev,
+  nagi_mt6835_config_t *pconfig,
+  bool enable_crc_check
+);
+
+/// @brief Read write function with user context, @ref nagi_mt6835_read_write_ctx_fn_t.
+/// @param[in] ctx spidev transport.
+/// @param[in] tx_data tx data.
+/// @param[out] rx_data rx data.
+/// @param[in] size transfer size.
+/// @return 0 on success.
+int nagi_mt6835_spidev_read_write_ctx(void *ctx, uint8_t *tx_data, uint8_t *rx_data, size_t size);
+
+/// @brief Queue a prepared asynchronous request for the next flush.
+/// @param[in] pspidev spidev transport.
+/// @param[in] pmt6835 mt6835 handle the request was prepared for.
+/// @param[in] preq prepared request, owned by the caller until flushed.
+/// @return mt6835 error code, NAGI_MT6835_ERROR when the batch is full.
+nagi_mt6835_error_t nagi_mt6835_spidev_queue(
+  nagi_mt6835_spidev_t *pspidev,
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq
+);
+
+/// @brief Run the queued transactions in one SPI_IOC_MESSAGE and complete their requests in order.
+/// @param[in] pspidev spidev transport.
+/// @return mt6835 error code, first failed request.
+nagi_mt6835_error_t nagi_mt6835_spidev_flush(nagi_mt6835_spidev_t *pspidev);
+
+/// @brief Read the raw angle of several devices, one ioctl per spidev node.
+/// @note The angle frame is the ANGLE3 burst a NORMAL read clocks. Devices must be configured with
+///       @ref nagi_mt6835_spidev_make_config, results are in reqs[i].raw_angle, .warning and .result.
+/// @param[in] devices mt6835 handles.
+/// @param[out] reqs request storage, count entries.
+/// @param[in] count device count.
+/// @return mt6835 error code, first failed request.
+nagi_mt6835_error_t nagi_mt6835_spidev_poll_angles(
+  nagi_mt6835_t **devices,
+  nagi_mt6835_async_req_t *reqs,
+  size_t count
+);
+
+/// @brief Apply a profile like @ref nagi_mt6835_profile_apply, with the writes and the EEPROM
+///        program batched into one ioctl after the configuration read.
+/// @param[in] pmt6835 mt6835 handle, configured with @ref nagi_mt6835_spidev_make_config.
+/// @param[in] pprofile profile.
+/// @param[in] program_eeprom program EEPROM when registers changed.
+/// @param[out] presult apply result, may be NULL.
+/// @return mt6835 error code.
+nagi_mt6835_error_t nagi_mt6835_spidev_apply_profile(
+  nagi_mt6835_t *pmt6835,
+  const nagi_mt6835_profile_t *pprofile,
+  bool program_eeprom,
+  nagi_mt6835_profile_result_t *presult
+);
+
+/// @brief ioctl shim forwarding spidev requests to a simulator, @ref nagi_mt6835_spidev_ioctl_fn_t.
+/// @note Mode, word size and clock requests are accepted, messages run transfer by transfer with
+///       the chip select toggled as cs_change asks.
+/// @param[in] ctx simulator, nagi_mt6835_sim_t.
+/// @param[in] fd unused.
+/// @param[in] request ioctl request.
+/// @param[in,out] arg ioctl argument.
+/// @return 0 or the transfer length on success, -1 on error.
+int nagi_mt6835_spidev_sim_ioctl(void *ctx, int fd, unsigned long request, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __linux__
+
+#endif // __NAGI_MT6835_SPIDEV_H__
@@ -11,7 +11,7 @@
 #define RAD_TO_DEG (57.29577951308232)
 #endif
 
-static uint8_t crc8_table[256] = {
+const uint8_t nagi_mt6835_crc8_table[256] = {
   0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
   0x70, 0x77, 0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53, 0x5a, 0x5d,
   0xe0, 0xe7, 0xee, 0xe9, 0xfc, 0xfb, 0xf2, 0xf5, 0xd8, 0xdf, 0xd6, 0xd1, 0xc4, 0xc3, 0xca, 0xcd,
@@ -30,6 +30,8 @@ static uint8_t crc8_table[256] = {
   0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3,
 };
 
+const uint8_t nagi_mt6835_continuous_read_tx[6] = NAGI_MT6835_CONTINUOUS_READ_TX_INIT;
+
 /// @brief CRC check.
 /// @param data The data to be checked.
 /// @param len The length of the data.
@@ -39,33 +41,174 @@ static uint8_t crc_table(const uint8_t *data, uint8_t len) {
 
   for (uint8_t i = 0; i < len; i++) {
     crc ^= data[i]; // 与数据异或
-    crc = crc8_table[crc]; // 查表更新CRC
+    crc = nagi_mt6835_crc8_table[crc]; // 查表更新CRC
   }
 
   return crc;
 }
 
+/// @brief Encode a mt6835 command frame without touching the handle.
+/// @param[out] tx_data tx data, 3 bytes.
+/// @param[in] cmd command.
+/// @param[in] reg register address.
+/// @param[in] data data byte.
+static void mt6835_encode_frame(uint8_t *tx_data, nagi_mt6835_cmd_enum_t cmd, nagi_mt6835_reg_enum_t reg, uint8_t data) {
+  tx_data[0] = NAGI_MT6835_FRAME_BYTE0(cmd, reg);
+  tx_data[1] = NAGI_MT6835_FRAME_BYTE1(reg);
+  tx_data[2] = data;
+}
+
+/// @brief Drive mt6835 chip select.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] select chip select asserted.
+static void mt6835_chip_select(nagi_mt6835_t *pmt6835, bool select) {
+  if (pmt6835->chip_select_ctx_fn != NULL) {
+    pmt6835->chip_select_ctx_fn(pmt6835->user_ctx, select);
+  } else {
+    pmt6835->chip_select_fn(select);
+  }
+}
+
+/// @brief Clock mt6835 bytes.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] tx_data tx data.
+/// @param[out] rx_data rx data.
+/// @param[in] size transfer size.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_read_write(nagi_mt6835_t *pmt6835, uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  if (pmt6835->read_write_ctx_fn != NULL) {
+    return pmt6835->read_write_ctx_fn(pmt6835->user_ctx, tx_data, rx_data, size);
+  }
+  return pmt6835->read_write_fn(tx_data, rx_data, size);
+}
+
+#if NAGI_MT6835_ENABLE_STATS
+/// @brief Open a statistics update, readers retry or back off while the sequence is odd.
+/// @param[in] pmt6835 mt6835 handle.
+static void mt6835_stats_begin(nagi_mt6835_t *pmt6835) {
+  pmt6835->stats_seq++;
+}
+
+/// @brief Close a statistics update.
+/// @param[in] pmt6835 mt6835 handle.
+static void mt6835_stats_end(nagi_mt6835_t *pmt6835) {
+  pmt6835->stats_seq++;
+}
+
+/// @brief Count a transaction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] size transfer size.
+/// @param[in] cycles transfer cycles, ignored without a cycle counter.
+static void mt6835_stats_transfer(nagi_mt6835_t *pmt6835, size_t size, uint32_t cycles) {
+  // Bucket is the bit length of the cycle count.
+  uint32_t bucket = 0;
+  for (uint32_t shift = 16; shift > 0; shift >>= 1) {
+    if (cycles >= (1u << shift)) {
+      cycles >>= shift;
+      bucket += shift;
+    }
+  }
+  bucket += cycles;
+
+  mt6835_stats_begin(pmt6835);
+  pmt6835->stats.transactions++;
+  pmt6835->stats.bytes += (uint32_t)size;
+  if (pmt6835->cycle_counter_fn != NULL) {
+    pmt6835->stats.latency[bucket]++;
+  }
+  mt6835_stats_end(pmt6835);
+}
+
+/// @brief Count a decoded angle sample.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] warning warning bits.
+/// @param[in] crc_failed CRC check failed.
+static void mt6835_stats_sample(nagi_mt6835_t *pmt6835, uint8_t warning, bool crc_failed) {
+  mt6835_stats_begin(pmt6835);
+  pmt6835->stats.samples++;
+  pmt6835->stats.crc_failures += crc_failed;
+  pmt6835->stats.over_speed += (warning & NAGI_MT6835_WARN_OVER_SPEED) != 0;
+  pmt6835->stats.field_weak += (warning & NAGI_MT6835_WARN_FIELD_WEAK) != 0;
+  pmt6835->stats.under_voltage += (warning & NAGI_MT6835_WARN_UNDER_VOLTAGE) != 0;
+  mt6835_stats_end(pmt6835);
+}
+
+/// @brief Count an API result.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] api API, @ref nagi_mt6835_stats_api_enum_t.
+/// @param[in] err result.
+/// @return err, unchanged.
+static nagi_mt6835_error_t mt6835_stats_result(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_stats_api_enum_t api,
+  nagi_mt6835_error_t err
+) {
+  // Transport functions may return any int, count those as generic errors.
+  const unsigned int index = (unsigned int)err < NAGI_MT6835_STATS_ERROR_COUNT ? (unsigned int)err : NAGI_MT6835_ERROR;
+
+  mt6835_stats_begin(pmt6835);
+  pmt6835->stats.results[api][index]++;
+  mt6835_stats_end(pmt6835);
+
+  return err;
+}
+
+/// @brief Add to a counter.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] pcounter counter in the statistics.
+/// @param[in] count count to add.
+static void mt6835_stats_add(nagi_mt6835_t *pmt6835, volatile uint32_t *pcounter, uint32_t count) {
+  mt6835_stats_begin(pmt6835);
+  *pcounter += count;
+  mt6835_stats_end(pmt6835);
+}
+
+#define MT6835_STATS_RESULT(pmt6835, api, err) mt6835_stats_result((pmt6835), (api), (err))
+#define MT6835_STATS_ADD(pmt6835, field, count) mt6835_stats_add((pmt6835), &(pmt6835)->stats.field, (count))
+#else
+#define MT6835_STATS_RESULT(pmt6835, api, err) (err)
+#define MT6835_STATS_ADD(pmt6835, field, count) ((void)0)
+#endif
+
+/// @brief Run one chip select framed mt6835 transaction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] tx_data tx data.
+/// @param[out] rx_data rx data.
+/// @param[in] size transfer size.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_transfer(nagi_mt6835_t *pmt6835, uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  mt6835_chip_select(pmt6835, true);
+#if NAGI_MT6835_ENABLE_STATS
+  const uint32_t start = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+  nagi_mt6835_error_t err = mt6835_read_write(pmt6835, tx_data, rx_data, size);
+  const uint32_t stop = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+  mt6835_stats_transfer(pmt6835, size, stop - start);
+#else
+  nagi_mt6835_error_t err = mt6835_read_write(pmt6835, tx_data, rx_data, size);
+#endif
+  mt6835_chip_select(pmt6835, false);
+
+  return err;
+}
+
 /// @brief Read mt6835 register.
 /// @param[in] pmt6835 mt6835 handle.
 /// @param[in] reg register address, @ref mt6835_reg_enum_t.
 /// @param[out] data data.
 /// @return mt6835 error code.
 static nagi_mt6835_error_t mt6835_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t* data) {
+  uint8_t tx_buf[3] = {0, 0, 0};
   uint8_t result[3] = {0, 0, 0};
 
-  pmt6835->chip_select_fn(false);
-  pmt6835->data_frame.cmd = NAGI_MT6835_CMD_RD; // byte read command
-  pmt6835->data_frame.reg = reg;
+  mt6835_chip_select(pmt6835, false);
+  mt6835_encode_frame(tx_buf, NAGI_MT6835_CMD_RD, reg, 0x00); // byte read command
 
-  pmt6835->chip_select_fn(true);
-  nagi_mt6835_error_t err = pmt6835->read_write_fn((uint8_t *)&pmt6835->data_frame.pack, (uint8_t *)&result, 3);
-  pmt6835->chip_select_fn(false);
-  if (err != NAGI_MT6835_OK) {
-    return err;
+  nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, result, 3);
+  if (err == NAGI_MT6835_OK) {
+    *data = result[2];
   }
 
-  *data = result[2];
-  return NAGI_MT6835_OK;
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_READ_REG, err);
 }
 
 /// @brief Write mt6835 register.
@@ -74,23 +217,166 @@ static nagi_mt6835_error_t mt6835_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_r
 /// @param[in] data data to write.
 /// @return mt6835 error code.
 static nagi_mt6835_error_t mt6835_write_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t data) {
+  uint8_t tx_buf[3] = {0, 0, 0};
   uint8_t result[3] = {0, 0, 0};
 
-  pmt6835->chip_select_fn(false);
-  pmt6835->data_frame.cmd = NAGI_MT6835_CMD_WR; // byte write command
-  pmt6835->data_frame.reg = reg;
-  pmt6835->data_frame.normal_byte = data;
+  mt6835_chip_select(pmt6835, false);
+  mt6835_encode_frame(tx_buf, NAGI_MT6835_CMD_WR, reg, data); // byte write command
+
+  nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, result, 3);
+
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_WRITE_REG, err);
+}
+
+/// @brief Read contiguous mt6835 registers in one transaction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] reg first register address, @ref mt6835_reg_enum_t.
+/// @param[out] data data, count bytes.
+/// @param[in] count register count, at most @ref NAGI_MT6835_BURST_MAX.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_read_regs(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t *data,
+  size_t count
+) {
+  uint8_t tx_buf[2 + NAGI_MT6835_BURST_MAX] = {0};
+  uint8_t rx_buf[2 + NAGI_MT6835_BURST_MAX] = {0};
+
+  mt6835_chip_select(pmt6835, false);
+  tx_buf[0] = NAGI_MT6835_FRAME_BYTE0(NAGI_MT6835_CMD_CONTINUE, reg); // burst read command
+  tx_buf[1] = NAGI_MT6835_FRAME_BYTE1(reg);
 
-  pmt6835->chip_select_fn(true);
-  nagi_mt6835_error_t err = pmt6835->read_write_fn((uint8_t *)&pmt6835->data_frame.pack, (uint8_t *)&result, 3);
-  pmt6835->chip_select_fn(false);
+  nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, rx_buf, 2 + count);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
 
+  memcpy(data, &rx_buf[2], count);
   return NAGI_MT6835_OK;
 }
 
+/// @brief Map a corrected raw angle to the software zero and direction.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] raw_angle corrected raw angle.
+/// @return mapped raw angle.
+static uint32_t mt6835_soft_zero_map(const nagi_mt6835_t *pmt6835, uint32_t raw_angle) {
+  const uint32_t angle = pmt6835->soft_reverse ? pmt6835->soft_zero - raw_angle : raw_angle - pmt6835->soft_zero;
+  return angle & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+}
+
+/// @brief Map a raw angle of the software frame back to a corrected raw angle.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] raw_angle mapped raw angle.
+/// @return corrected raw angle.
+static uint32_t mt6835_soft_zero_unmap(const nagi_mt6835_t *pmt6835, uint32_t raw_angle) {
+  const uint32_t angle = pmt6835->soft_reverse ? pmt6835->soft_zero - raw_angle : raw_angle + pmt6835->soft_zero;
+  return angle & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+}
+
+/// @brief Decode angle bytes ANGLE3, ANGLE2, ANGLE1 and CRC.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] data angle bytes, CRC byte only read with CRC check enabled.
+/// @param[out] praw_angle raw angle.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_decode_angle(nagi_mt6835_t *pmt6835, const uint8_t *data, uint32_t *praw_angle) {
+  pmt6835->warning = data[2] & 0x07;
+  if (pmt6835->enable_crc_check) {
+    pmt6835->crc_res = crc_table(data, 3) == data[3];
+  }
+#if NAGI_MT6835_ENABLE_STATS
+  mt6835_stats_sample(pmt6835, pmt6835->warning, pmt6835->enable_crc_check && !pmt6835->crc_res);
+#endif
+  if (pmt6835->enable_crc_check && !pmt6835->crc_res) {
+    return NAGI_MT6835_CRC_CHECK_FAILED;
+  }
+
+  *praw_angle = (data[0] << 13) | (data[1] << 5) | (data[2] >> 3);
+  if (pmt6835->angle_correct_fn != NULL) {
+    *praw_angle = pmt6835->angle_correct_fn(pmt6835->angle_correct_ctx, *praw_angle);
+  }
+  *praw_angle = mt6835_soft_zero_map(pmt6835, *praw_angle);
+
+  pmt6835->last_good_raw_angle = *praw_angle;
+  pmt6835->last_good_valid = true;
+  pmt6835->fallback_count = 0;
+  return NAGI_MT6835_OK;
+}
+
+/// @brief Answer a CRC failed angle read from the recovery fallback.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] err angle read result.
+/// @param[out] praw_angle raw angle, set when the fallback answers.
+/// @return err, or NAGI_MT6835_OK when the fallback answers.
+static nagi_mt6835_error_t mt6835_angle_fallback(nagi_mt6835_t *pmt6835, nagi_mt6835_error_t err, uint32_t *praw_angle) {
+  const nagi_mt6835_recovery_t *precovery = &pmt6835->recovery;
+  if (err != NAGI_MT6835_CRC_CHECK_FAILED || precovery->fallback == NAGI_MT6835_FALLBACK_NONE || !pmt6835->last_good_valid) {
+    return err;
+  }
+  if (precovery->max_fallbacks != 0 && pmt6835->fallback_count >= precovery->max_fallbacks) {
+    return err;
+  }
+
+  if (precovery->fallback == NAGI_MT6835_FALLBACK_PREDICTED) {
+    const uint32_t now = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+    *praw_angle = precovery->predict_fn(precovery->predict_ctx, now) & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+    pmt6835->angle_flags |= NAGI_MT6835_ANGLE_FLAG_PREDICTED;
+  } else {
+    *praw_angle = pmt6835->last_good_raw_angle;
+    pmt6835->angle_flags |= NAGI_MT6835_ANGLE_FLAG_LAST_GOOD;
+  }
+  pmt6835->fallback_count++;
+  MT6835_STATS_ADD(pmt6835, fallbacks, 1);
+
+  return NAGI_MT6835_OK;
+}
+
+/// @brief Check register is kept in the shadow copy.
+/// @param[in] reg register address, @ref mt6835_reg_enum_t.
+/// @return true if cacheable.
+static bool mt6835_shadow_cacheable(nagi_mt6835_reg_enum_t reg) {
+  if (reg < NAGI_MT6835_SHADOW_REG_FIRST || reg > NAGI_MT6835_SHADOW_REG_LAST) {
+    return false;
+  }
+  // Angle and CRC registers change with every sample.
+  return reg < NAGI_MT6835_REG_ANGLE3 || reg > NAGI_MT6835_REG_CRC;
+}
+
+/// @brief Load mt6835 register, from the shadow copy when valid.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] reg register address, @ref mt6835_reg_enum_t.
+/// @param[out] data data.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_load_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t *data) {
+  if (mt6835_shadow_cacheable(reg) && (pmt6835->shadow_valid & (1u << reg))) {
+    *data = pmt6835->shadow_regs[reg - NAGI_MT6835_SHADOW_REG_FIRST];
+    return NAGI_MT6835_OK;
+  }
+
+  return mt6835_read_reg(pmt6835, reg, data);
+}
+
+/// @brief Store mt6835 register, keeping a valid shadow copy up to date.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] reg register address, @ref mt6835_reg_enum_t.
+/// @param[in] data data to write.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_store_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t data) {
+  nagi_mt6835_error_t err = mt6835_write_reg(pmt6835, reg, data);
+  if (!mt6835_shadow_cacheable(reg)) {
+    return err;
+  }
+
+  if (err != NAGI_MT6835_OK) {
+    // Device state is unknown after a failed write.
+    pmt6835->shadow_valid &= ~(1u << reg);
+  } else if (pmt6835->shadow_valid & (1u << reg)) {
+    pmt6835->shadow_regs[reg - NAGI_MT6835_SHADOW_REG_FIRST] = data;
+  }
+
+  return err;
+}
+
 nagi_mt6835_error_t nagi_mt6835_init(nagi_mt6835_t *pmt6835, const nagi_mt6835_config_t *pconfig) {
   if (pmt6835 == NULL) {
     return NAGI_MT6835_HANDLE_NULL;
@@ -98,7 +384,9 @@ nagi_mt6835_error_t nagi_mt6835_init(nagi_mt6835_t *pmt6835, const nagi_mt6835_c
   if (pconfig == NULL) {
     return NAGI_MT6835_POINTER_NULL;
   }
-  if (pconfig->chip_select_fn == NULL || pconfig->read_write_fn == NULL || pconfig->delay_fn == NULL) {
+  if ((pconfig->chip_select_fn == NULL && pconfig->chip_select_ctx_fn == NULL) ||
+      (pconfig->read_write_fn == NULL && pconfig->read_write_ctx_fn == NULL) ||
+      pconfig->delay_fn == NULL) {
     return NAGI_MT6835_INVALID_ARGUMENT;
   }
 
@@ -107,12 +395,44 @@ nagi_mt6835_error_t nagi_mt6835_init(nagi_mt6835_t *pmt6835, const nagi_mt6835_c
   pmt6835->delay_fn = pconfig->delay_fn;
   pmt6835->enable_crc_check = pconfig->enable_crc_check;
 
-  pmt6835->data_frame.pack = 0;
   pmt6835->crc_res = false;
   pmt6835->warning = NAGI_MT6835_WARN_NONE;
 
   pmt6835->is_custom_continuous_reading = false;
 
+  memset(pmt6835->shadow_regs, 0, sizeof(pmt6835->shadow_regs));
+  pmt6835->shadow_valid = 0;
+
+  pmt6835->start_transfer_fn = pconfig->start_transfer_fn;
+  pmt6835->chip_select_ctx_fn = pconfig->chip_select_ctx_fn;
+  pmt6835->read_write_ctx_fn = pconfig->read_write_ctx_fn;
+  pmt6835->start_transfer_ctx_fn = pconfig->start_transfer_ctx_fn;
+  pmt6835->user_ctx = pconfig->user_ctx;
+  pmt6835->async_head = NULL;
+  pmt6835->async_tail = NULL;
+
+  pmt6835->angle_correct_fn = NULL;
+  pmt6835->angle_correct_ctx = NULL;
+  pmt6835->soft_zero = 0;
+  pmt6835->soft_reverse = false;
+
+  pmt6835->cycle_counter_fn = pconfig->cycle_counter_fn;
+
+  memset(&pmt6835->recovery, 0, sizeof(pmt6835->recovery));
+  pmt6835->angle_flags = NAGI_MT6835_ANGLE_FLAG_NONE;
+  pmt6835->last_good_valid = false;
+  pmt6835->last_good_raw_angle = 0;
+  pmt6835->fallback_count = 0;
+
+  memset(pmt6835->sample_hooks, 0, sizeof(pmt6835->sample_hooks));
+  pmt6835->sample_hook_count = 0;
+  pmt6835->sample_seq = 0;
+#if NAGI_MT6835_ENABLE_STATS
+  pmt6835->stats_seq = 0;
+  pmt6835->async_start_cycle = 0;
+  nagi_mt6835_reset_stats(pmt6835);
+#endif
+
   return NAGI_MT6835_OK;
 }
 
@@ -121,7 +441,7 @@ nagi_mt6835_error_t nagi_mt6835_set_id(nagi_mt6835_t *pmt6835, uint8_t custom_id
     return NAGI_MT6835_HANDLE_NULL;
   }
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ID, custom_id);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ID, custom_id);
 }
 
 nagi_mt6835_error_t nagi_mt6835_get_id(nagi_mt6835_t *pmt6835, uint8_t *pcustom_id) {
@@ -140,174 +460,482 @@ nagi_mt6835_error_t nagi_mt6835_auto_zero_angle(nagi_mt6835_t *pmt6835) {
     return NAGI_MT6835_HANDLE_NULL;
   }
 
+  uint8_t tx_buf[3] = {0, 0, 0};
   uint8_t result[3] = {0, 0, 0};
 
-  pmt6835->chip_select_fn(false);
-  pmt6835->data_frame.cmd = NAGI_MT6835_CMD_ZERO;
-  pmt6835->data_frame.reg = 0x00;
-  pmt6835->data_frame.normal_byte = 0x00;
+  mt6835_chip_select(pmt6835, false);
+  mt6835_encode_frame(tx_buf, NAGI_MT6835_CMD_ZERO, (nagi_mt6835_reg_enum_t)0x00, 0x00);
 
-  pmt6835->chip_select_fn(true);
-  nagi_mt6835_error_t err = pmt6835->read_write_fn((uint8_t *)&pmt6835->data_frame.pack, (uint8_t *)&result, 3);
-  pmt6835->chip_select_fn(false);
+  nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, result, 3);
+
+  // The chip rewrites the zero registers.
+  pmt6835->shadow_valid &= ~((1u << NAGI_MT6835_REG_ZERO2) | (1u << NAGI_MT6835_REG_ZERO1));
 
   if (result[2] != 0x55) {
-    return NAGI_MT6835_ERROR;
+    err = NAGI_MT6835_ERROR;
   }
 
-  return err;
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_AUTO_ZERO, err);
 }
 
-nagi_mt6835_error_t nagi_mt6835_set_zero_angle(nagi_mt6835_t *pmt6835, float rad) {
-  if (pmt6835 == NULL) {
-    return NAGI_MT6835_HANDLE_NULL;
-  }
-
-  uint16_t angle = (uint16_t)roundf(rad * RAD_TO_DEG / NAGI_MT6835_ZERO_REG_STEP);
-  if (angle > 0xFFF) {
-    return NAGI_MT6835_INVALID_ARGUMENT;
-  }
-
+/// @brief Write the zero position registers.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] zero zero position(0x000 - 0xFFF).
+/// @param[in] zero1 current ZERO1 value, its low bits are kept.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_store_raw_zero_angle(nagi_mt6835_t *pmt6835, uint16_t zero, uint8_t zero1) {
   uint8_t tx_buf[2] = {0};
 
-  tx_buf[1] = angle >> 4;
-  tx_buf[0] = (angle & 0x0F) << 4;
+  tx_buf[1] = zero >> 4;
+  tx_buf[0] = ((zero & 0x0F) << 4) | (zero1 & 0x0F);
 
-  uint8_t zero1 = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &zero1);
+  nagi_mt6835_error_t err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO2, tx_buf[1]);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
-  tx_buf[0] |= zero1 & 0x0F;
-
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO2, tx_buf[1]);
+  err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO1, tx_buf[0]);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO1, tx_buf[0]);
+
+  return NAGI_MT6835_OK;
+}
+
+/// @brief Write the zero position registers, keeping the low bits of ZERO1.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] zero zero position(0x000 - 0xFFF).
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_set_raw_zero_angle(nagi_mt6835_t *pmt6835, uint16_t zero) {
+  uint8_t zero1 = 0;
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &zero1);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
 
-  return NAGI_MT6835_OK;
+  return mt6835_store_raw_zero_angle(pmt6835, zero, zero1);
 }
 
-nagi_mt6835_error_t nagi_mt6835_get_raw_angle(
-  nagi_mt6835_t *pmt6835,
-  nagi_mt6835_read_angle_method_enum_t method,
-  uint32_t *praw_angle
-) {
+nagi_mt6835_error_t nagi_mt6835_set_zero_angle(nagi_mt6835_t *pmt6835, float rad) {
   if (pmt6835 == NULL) {
     return NAGI_MT6835_HANDLE_NULL;
   }
-  if (praw_angle == NULL) {
-    return NAGI_MT6835_POINTER_NULL;
+
+  uint16_t angle = (uint16_t)roundf(rad * RAD_TO_DEG / NAGI_MT6835_ZERO_REG_STEP);
+  if (angle > 0xFFF) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
   }
 
+  return mt6835_set_raw_zero_angle(pmt6835, angle);
+}
+
+/// @brief Read mt6835 raw angle.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[out] praw_angle raw angle.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_get_raw_angle(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  uint32_t *praw_angle
+) {
   uint8_t rx_buf[6] = {0};
   uint8_t tx_buf[6] = {0};
 
   switch (method) {
     case NAGI_MT6835_READ_ANGLE_METHOD_NORMAL: {
-      nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ANGLE3, &rx_buf[0]);
+      // ANGLE3, ANGLE2, ANGLE1 and CRC in one burst, so all bytes belong to the same sample.
+      const size_t len = pmt6835->enable_crc_check ? 4 : 3;
+      nagi_mt6835_error_t err = mt6835_read_regs(pmt6835, NAGI_MT6835_REG_ANGLE3, rx_buf, len);
       if (err != NAGI_MT6835_OK) {
         return err;
       }
-      err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ANGLE2, &rx_buf[1]);
-      if (err != NAGI_MT6835_OK) {
-        return err;
-      }
-      err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ANGLE1, &rx_buf[2]);
-      if (err != NAGI_MT6835_OK) {
-        return err;
-      }
-      if (pmt6835->enable_crc_check) {
-        err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_CRC, &rx_buf[3]);
-        if (err != NAGI_MT6835_OK) {
-          return err;
-        }
-      }
       break;
     }
     case NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE: {
       const uint8_t len = pmt6835->enable_crc_check ? 6 : 5;
 
-      pmt6835->chip_select_fn(false);
-      pmt6835->data_frame.cmd = NAGI_MT6835_CMD_CONTINUE;
-      pmt6835->data_frame.reg = NAGI_MT6835_REG_ANGLE3;
-      tx_buf[0] = pmt6835->data_frame.pack & 0xFF;
-      tx_buf[1] = (pmt6835->data_frame.pack >> 8) & 0xFF;
+      mt6835_chip_select(pmt6835, false);
+      memcpy(tx_buf, nagi_mt6835_continuous_read_tx, sizeof(tx_buf));
 
-      pmt6835->chip_select_fn(true);
-      nagi_mt6835_error_t err = pmt6835->read_write_fn(tx_buf, rx_buf, len);
-      pmt6835->chip_select_fn(false);
+      nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, rx_buf, len);
       if (err != NAGI_MT6835_OK) {
         return err;
       }
 
-      memmove(rx_buf, &rx_buf[2], 3);
-      if (pmt6835->enable_crc_check) {
-        rx_buf[3] = rx_buf[5];
+      // Angle bytes and CRC follow the 2 command bytes.
+      return mt6835_decode_angle(pmt6835, &rx_buf[2], praw_angle);
+    }
+  }
+
+  return mt6835_decode_angle(pmt6835, rx_buf, praw_angle);
+}
+
+/// @brief Flag a failed transfer and hand the result of an angle read to the sample hooks.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] err angle read result.
+/// @param[in] raw_angle raw angle returned by the read.
+static void mt6835_publish_sample(nagi_mt6835_t *pmt6835, nagi_mt6835_error_t err, uint32_t raw_angle) {
+  // Anything but a decoded frame, good or with a bad CRC, means nothing was measured.
+  const bool bus_error = err != NAGI_MT6835_OK && err != NAGI_MT6835_CRC_CHECK_FAILED;
+  if (bus_error) {
+    pmt6835->angle_flags |= NAGI_MT6835_ANGLE_FLAG_BUS_ERROR;
+  }
+  if (pmt6835->sample_hook_count == 0) {
+    return;
+  }
+
+  nagi_mt6835_sample_t sample;
+  sample.raw_angle = err == NAGI_MT6835_OK ? raw_angle : pmt6835->last_good_raw_angle;
+  sample.timestamp = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+  sample.seq = pmt6835->sample_seq++;
+  sample.warning = pmt6835->warning;
+  sample.crc_ok = !bus_error && (!pmt6835->enable_crc_check || pmt6835->crc_res);
+  sample.angle_flags = pmt6835->angle_flags;
+  for (uint8_t i = 0; i < pmt6835->sample_hook_count; i++) {
+    pmt6835->sample_hooks[i].fn(pmt6835->sample_hooks[i].ctx, &sample);
+  }
+}
+
+/// @brief Read mt6835 raw angle, retrying CRC failures within the recovery budgets.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] method read angle method.
+/// @param[out] praw_angle raw angle.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t mt6835_get_raw_angle_retry(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  uint32_t *praw_angle
+) {
+  const nagi_mt6835_recovery_t *precovery = &pmt6835->recovery;
+  const bool timed = precovery->time_budget != 0;
+  const uint32_t start = timed ? pmt6835->cycle_counter_fn() : 0;
+
+  nagi_mt6835_error_t err = mt6835_get_raw_angle(pmt6835, method, praw_angle);
+  for (uint32_t attempt = 1; err == NAGI_MT6835_CRC_CHECK_FAILED && attempt <= precovery->max_retries; attempt++) {
+    if (timed) {
+      // Only start another attempt when a worst case one still fits.
+      const uint32_t elapsed = pmt6835->cycle_counter_fn() - start;
+      if (elapsed > precovery->time_budget - precovery->attempt_cycles) {
+        pmt6835->angle_flags |= NAGI_MT6835_ANGLE_FLAG_BUDGET_EXHAUSTED;
+        break;
       }
-      break;
     }
+    pmt6835->angle_flags |= NAGI_MT6835_ANGLE_FLAG_RETRIED;
+    MT6835_STATS_ADD(pmt6835, retries, 1);
+    err = mt6835_get_raw_angle(pmt6835, method, praw_angle);
+  }
+
+  return err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_raw_angle(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  uint32_t *praw_angle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (praw_angle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  pmt6835->angle_flags = NAGI_MT6835_ANGLE_FLAG_NONE;
+  nagi_mt6835_error_t err = mt6835_get_raw_angle_retry(pmt6835, method, praw_angle);
+  err = mt6835_angle_fallback(pmt6835, err, praw_angle);
+  mt6835_publish_sample(pmt6835, err, *praw_angle);
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_GET_ANGLE, err);
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_raw_zero_angle(nagi_mt6835_t *pmt6835, uint16_t *praw_zero_angle) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (praw_zero_angle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint8_t rx_buf[2] = {0};
+  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO2, &rx_buf[1]);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+  err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &rx_buf[0]);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *praw_zero_angle = (rx_buf[1] << 4) | (rx_buf[0] >> 4);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_angle(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  float *prad_angle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (prad_angle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *prad_angle = nagi_mt6835_raw_to_rad_f32(raw_angle);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_angle_q31(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  int32_t *pq31_angle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pq31_angle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *pq31_angle = nagi_mt6835_raw_to_q31(raw_angle);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_angle_u16(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  uint16_t *pu16_angle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pu16_angle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *pu16_angle = nagi_mt6835_raw_to_u16(raw_angle);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_angle_unit(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  nagi_mt6835_angle_t *pangle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pangle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *pangle = nagi_mt6835_raw_to_angle(raw_angle);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_set_angle_correction(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_angle_correct_fn_t correct_fn,
+  void *ctx
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  pmt6835->angle_correct_fn = correct_fn;
+  pmt6835->angle_correct_ctx = ctx;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_set_soft_zero(nagi_mt6835_t *pmt6835, uint32_t raw_zero, bool reverse) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (raw_zero >= NAGI_MT6835_ANGLE_RESOLUTION) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  const uint32_t last_good = mt6835_soft_zero_unmap(pmt6835, pmt6835->last_good_raw_angle);
+  pmt6835->soft_zero = raw_zero;
+  pmt6835->soft_reverse = reverse;
+  pmt6835->last_good_raw_angle = mt6835_soft_zero_map(pmt6835, last_good);
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_shift_soft_zero(nagi_mt6835_t *pmt6835, uint32_t raw_angle) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  // The corrected raw angle that reads raw_angle now reads 0 afterwards.
+  return nagi_mt6835_set_soft_zero(pmt6835, mt6835_soft_zero_unmap(pmt6835, raw_angle), pmt6835->soft_reverse);
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_soft_zero(const nagi_mt6835_t *pmt6835, uint32_t *praw_zero, bool *preverse) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (praw_zero == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  *praw_zero = pmt6835->soft_zero;
+  if (preverse != NULL) {
+    *preverse = pmt6835->soft_reverse;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_fold_soft_zero(nagi_mt6835_t *pmt6835, bool program_eeprom) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  // Both zero registers once, ZERO1 also keeps its low bits for the write back.
+  uint8_t zero2 = 0;
+  uint8_t zero1 = 0;
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO2, &zero2);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+  err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &zero1);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+  const uint16_t chip_zero = (uint16_t)((zero2 << 4) | (zero1 >> 4));
+
+  // The chip subtracts its zero before the software frame in either direction, so the total
+  // offset is their sum. The nearest register step takes it, the remainder stays in software.
+  const uint32_t total = ((uint32_t)chip_zero * NAGI_MT6835_ZERO_REG_RAW_STEP + pmt6835->soft_zero) &
+                         (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  const uint16_t new_chip_zero =
+    (uint16_t)(((total + NAGI_MT6835_ZERO_REG_RAW_STEP / 2) / NAGI_MT6835_ZERO_REG_RAW_STEP) & 0xFFF);
+  const uint32_t remainder = (total - (uint32_t)new_chip_zero * NAGI_MT6835_ZERO_REG_RAW_STEP) &
+                             (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+
+  err = mt6835_store_raw_zero_angle(pmt6835, new_chip_zero, zero1);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  // The corrected raw angle moved with the chip zero, only the software zero changes the frame.
+  pmt6835->soft_zero = remainder;
+
+  if (program_eeprom) {
+    return nagi_mt6835_program_eeprom(pmt6835);
+  }
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_set_recovery(nagi_mt6835_t *pmt6835, const nagi_mt6835_recovery_t *precovery) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  if (precovery == NULL) {
+    memset(&pmt6835->recovery, 0, sizeof(pmt6835->recovery));
+    return NAGI_MT6835_OK;
+  }
+  if (precovery->fallback > NAGI_MT6835_FALLBACK_PREDICTED ||
+      (precovery->fallback == NAGI_MT6835_FALLBACK_PREDICTED && precovery->predict_fn == NULL) ||
+      (precovery->time_budget != 0 && pmt6835->cycle_counter_fn == NULL) ||
+      (precovery->time_budget != 0 &&
+       (precovery->attempt_cycles == 0 || precovery->attempt_cycles > precovery->time_budget))) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  pmt6835->recovery = *precovery;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_set_sample_hook(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
   }
 
-  pmt6835->warning = rx_buf[2] & 0x07;
-  if (pmt6835->enable_crc_check) {
-    if (crc_table(rx_buf, 3) != rx_buf[3]) {
-      pmt6835->crc_res = false;
-      return NAGI_MT6835_CRC_CHECK_FAILED;
-    }
-    pmt6835->crc_res = true;
+  pmt6835->sample_hook_count = 0;
+  if (sample_fn == NULL) {
+    return NAGI_MT6835_OK;
   }
-
-  *praw_angle = (rx_buf[0] << 13) | (rx_buf[1] << 5) | (rx_buf[2] >> 3);
-
-  return NAGI_MT6835_OK;
+  return nagi_mt6835_add_sample_hook(pmt6835, sample_fn, ctx);
 }
 
-nagi_mt6835_error_t nagi_mt6835_get_raw_zero_angle(nagi_mt6835_t *pmt6835, uint16_t *praw_zero_angle) {
+nagi_mt6835_error_t nagi_mt6835_add_sample_hook(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
+) {
   if (pmt6835 == NULL) {
     return NAGI_MT6835_HANDLE_NULL;
   }
-  if (praw_zero_angle == NULL) {
+  if (sample_fn == NULL) {
     return NAGI_MT6835_POINTER_NULL;
   }
 
-  uint8_t rx_buf[2] = {0};
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO2, &rx_buf[1]);
-  if (err != NAGI_MT6835_OK) {
-    return err;
+  for (uint8_t i = 0; i < pmt6835->sample_hook_count; i++) {
+    if (pmt6835->sample_hooks[i].fn == sample_fn && pmt6835->sample_hooks[i].ctx == ctx) {
+      return NAGI_MT6835_OK;
+    }
   }
-  err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &rx_buf[0]);
-  if (err != NAGI_MT6835_OK) {
-    return err;
+  if (pmt6835->sample_hook_count == NAGI_MT6835_SAMPLE_HOOK_MAX) {
+    return NAGI_MT6835_ERROR;
   }
 
-  *praw_zero_angle = (rx_buf[1] << 4) | (rx_buf[0] >> 4);
+  // Fill the slot before counting it, a read in between does not see a half set hook.
+  pmt6835->sample_hooks[pmt6835->sample_hook_count].fn = sample_fn;
+  pmt6835->sample_hooks[pmt6835->sample_hook_count].ctx = ctx;
+  pmt6835->sample_hook_count++;
   return NAGI_MT6835_OK;
 }
 
-nagi_mt6835_error_t nagi_mt6835_get_angle(
+nagi_mt6835_error_t nagi_mt6835_remove_sample_hook(
   nagi_mt6835_t *pmt6835,
-  nagi_mt6835_read_angle_method_enum_t method,
-  float *prad_angle
+  nagi_mt6835_sample_fn_t sample_fn,
+  void *ctx
 ) {
   if (pmt6835 == NULL) {
     return NAGI_MT6835_HANDLE_NULL;
   }
-  if (prad_angle == NULL) {
-    return NAGI_MT6835_POINTER_NULL;
-  }
 
-  uint32_t raw_angle = 0;
-  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
-  if (err != NAGI_MT6835_OK) {
-    return err;
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < pmt6835->sample_hook_count; i++) {
+    const nagi_mt6835_sample_hook_t hook = pmt6835->sample_hooks[i];
+    if (hook.fn != sample_fn || (ctx != NULL && hook.ctx != ctx)) {
+      pmt6835->sample_hooks[count++] = hook;
+    }
   }
-
-  *prad_angle = (float)(raw_angle * 2.996056226329803e-6);
+  pmt6835->sample_hook_count = count;
   return NAGI_MT6835_OK;
 }
 
@@ -335,7 +963,7 @@ nagi_mt6835_error_t nagi_mt6835_enable_abz_output(nagi_mt6835_t *pmt6835, bool e
   }
 
   uint8_t abz_res1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
@@ -346,7 +974,7 @@ nagi_mt6835_error_t nagi_mt6835_enable_abz_output(nagi_mt6835_t *pmt6835, bool e
     abz_res1_reg |= 0b00000010;
   }
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
 }
 
 nagi_mt6835_error_t nagi_mt6835_set_abz_ab_swap(nagi_mt6835_t *pmt6835, bool ab_swap) {
@@ -355,7 +983,7 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_ab_swap(nagi_mt6835_t *pmt6835, bool ab_
   }
 
   uint8_t abz_res1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
@@ -366,7 +994,7 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_ab_swap(nagi_mt6835_t *pmt6835, bool ab_
     abz_res1_reg &= 0b11111110;
   }
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
 }
 
 nagi_mt6835_error_t nagi_mt6835_set_abz_resolution(nagi_mt6835_t *pmt6835, uint16_t abz_res) {
@@ -378,17 +1006,17 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_resolution(nagi_mt6835_t *pmt6835, uint1
   }
 
   uint8_t abz_res1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, &abz_res1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
   abz_res1_reg = (abz_res1_reg & 0b00000011) | ((abz_res & 0b00111111) << 2);
   uint8_t abz_res2_reg = (abz_res >> 6) & 0xFF;
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES2, abz_res2_reg);
+  err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES2, abz_res2_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
+  err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ABZ_RES1, abz_res1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
@@ -405,16 +1033,16 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_z_position(nagi_mt6835_t *pmt6835, uint1
   }
 
   uint8_t abz_zero1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
   abz_zero1_reg = (abz_zero1_reg & 0b00001111) | ((abz_z_pos & 0b00001111) << 4);
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO2, abz_z_pos >> 4);
+  err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO2, abz_z_pos >> 4);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
-  err = mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
+  err = mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
@@ -428,7 +1056,7 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_z_edge_up(nagi_mt6835_t *pmt6835, bool a
   }
 
   uint8_t abz_zero1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
@@ -439,7 +1067,7 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_z_edge_up(nagi_mt6835_t *pmt6835, bool a
     abz_zero1_reg &= 0b11110111;
   }
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
 }
 
 nagi_mt6835_error_t nagi_mt6835_set_abz_z_pulse_width(nagi_mt6835_t *pmt6835, uint8_t abz_z_pulse_width) {
@@ -451,13 +1079,13 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_z_pulse_width(nagi_mt6835_t *pmt6835, ui
   }
 
   uint8_t abz_zero1_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_ZERO1, &abz_zero1_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
   abz_zero1_reg = (abz_zero1_reg & 0b11111000) | (abz_z_pulse_width & 0b00000111);
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_ZERO1, abz_zero1_reg);
 }
 
 nagi_mt6835_error_t nagi_mt6835_set_abz_z_phase(nagi_mt6835_t *pmt6835, uint8_t abz_z_phase) {
@@ -469,13 +1097,13 @@ nagi_mt6835_error_t nagi_mt6835_set_abz_z_phase(nagi_mt6835_t *pmt6835, uint8_t
   }
 
   uint8_t abz_uvw_reg = 0;
-  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, NAGI_MT6835_REG_UVW, &abz_uvw_reg);
+  nagi_mt6835_error_t err = mt6835_load_reg(pmt6835, NAGI_MT6835_REG_UVW, &abz_uvw_reg);
   if (err != NAGI_MT6835_OK) {
     return err;
   }
-  abz_uvw_reg = (abz_uvw_reg & 0b00111111) | (abz_z_phase & 0b11000000);
+  abz_uvw_reg = (abz_uvw_reg & 0b00111111) | ((abz_z_phase & 0b00000011) << 6);
 
-  return mt6835_write_reg(pmt6835, NAGI_MT6835_REG_UVW, abz_uvw_reg);
+  return mt6835_store_reg(pmt6835, NAGI_MT6835_REG_UVW, abz_uvw_reg);
 }
 
 nagi_mt6835_error_t nagi_mt6835_program_eeprom(nagi_mt6835_t *pmt6835) {
@@ -483,22 +1111,19 @@ nagi_mt6835_error_t nagi_mt6835_program_eeprom(nagi_mt6835_t *pmt6835) {
     return NAGI_MT6835_HANDLE_NULL;
   }
 
+  uint8_t tx_buf[3] = {0, 0, 0};
   uint8_t result[3] = {0, 0, 0};
 
-  pmt6835->chip_select_fn(false);
-  pmt6835->data_frame.cmd = NAGI_MT6835_CMD_EEPROM;
-  pmt6835->data_frame.reg = 0x00;
-  pmt6835->data_frame.normal_byte = 0x00;
+  mt6835_chip_select(pmt6835, false);
+  mt6835_encode_frame(tx_buf, NAGI_MT6835_CMD_EEPROM, (nagi_mt6835_reg_enum_t)0x00, 0x00);
 
-  pmt6835->chip_select_fn(true);
-  nagi_mt6835_error_t err = pmt6835->read_write_fn((uint8_t *)&pmt6835->data_frame.pack, (uint8_t *)&result, 3);
-  pmt6835->chip_select_fn(false);
+  nagi_mt6835_error_t err = mt6835_transfer(pmt6835, tx_buf, result, 3);
 
   if (result[2] != 0x55) {
-    return NAGI_MT6835_ERROR;
+    err = NAGI_MT6835_ERROR;
   }
 
-  return err;
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_PROGRAM_EEPROM, err);
 }
 
 nagi_mt6835_error_t nagi_mt6835_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t *pdata) {
@@ -509,7 +1134,12 @@ nagi_mt6835_error_t nagi_mt6835_read_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg
     return NAGI_MT6835_POINTER_NULL;
   }
 
-  return mt6835_read_reg(pmt6835, reg, pdata);
+  nagi_mt6835_error_t err = mt6835_read_reg(pmt6835, reg, pdata);
+  if (err == NAGI_MT6835_OK && mt6835_shadow_cacheable(reg) && (pmt6835->shadow_valid & (1u << reg))) {
+    pmt6835->shadow_regs[reg - NAGI_MT6835_SHADOW_REG_FIRST] = *pdata;
+  }
+
+  return err;
 }
 
 nagi_mt6835_error_t nagi_mt6835_write_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_reg_enum_t reg, uint8_t data) {
@@ -517,7 +1147,146 @@ nagi_mt6835_error_t nagi_mt6835_write_reg(nagi_mt6835_t *pmt6835, nagi_mt6835_re
     return NAGI_MT6835_HANDLE_NULL;
   }
 
-  return mt6835_write_reg(pmt6835, reg, data);
+  return mt6835_store_reg(pmt6835, reg, data);
+}
+
+nagi_mt6835_error_t nagi_mt6835_read_regs(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t *pdata,
+  size_t count
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pdata == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (count == 0 || count > NAGI_MT6835_BURST_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  nagi_mt6835_error_t err = mt6835_read_regs(pmt6835, reg, pdata, count);
+  if (err != NAGI_MT6835_OK) {
+    return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_READ_REG, err);
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const nagi_mt6835_reg_enum_t cur_reg = (nagi_mt6835_reg_enum_t)(reg + i);
+    if (mt6835_shadow_cacheable(cur_reg) && (pmt6835->shadow_valid & (1u << cur_reg))) {
+      pmt6835->shadow_regs[cur_reg - NAGI_MT6835_SHADOW_REG_FIRST] = pdata[i];
+    }
+  }
+
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_READ_REG, NAGI_MT6835_OK);
+}
+
+nagi_mt6835_error_t nagi_mt6835_write_regs(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_reg_enum_t reg,
+  const uint8_t *pdata,
+  size_t count
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pdata == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (count == 0 || count > NAGI_MT6835_BURST_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  // The chip only takes single byte writes, each one needs its own chip select frame.
+  for (size_t i = 0; i < count; i++) {
+    nagi_mt6835_error_t err = mt6835_store_reg(pmt6835, (nagi_mt6835_reg_enum_t)(reg + i), pdata[i]);
+    if (err != NAGI_MT6835_OK) {
+      return err;
+    }
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sync_shadow_regs(nagi_mt6835_t *pmt6835) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  pmt6835->shadow_valid = 0;
+  nagi_mt6835_error_t err = mt6835_read_regs(
+    pmt6835,
+    NAGI_MT6835_SHADOW_REG_FIRST,
+    pmt6835->shadow_regs,
+    NAGI_MT6835_SHADOW_REG_COUNT
+  );
+  if (err != NAGI_MT6835_OK) {
+    return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_READ_REG, err);
+  }
+
+  for (int reg = NAGI_MT6835_SHADOW_REG_FIRST; reg <= NAGI_MT6835_SHADOW_REG_LAST; reg++) {
+    if (mt6835_shadow_cacheable((nagi_mt6835_reg_enum_t)reg)) {
+      pmt6835->shadow_valid |= 1u << reg;
+    }
+  }
+
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_READ_REG, NAGI_MT6835_OK);
+}
+
+nagi_mt6835_error_t nagi_mt6835_invalidate_shadow_regs(nagi_mt6835_t *pmt6835) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  pmt6835->shadow_valid = 0;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_get_stats(const nagi_mt6835_t *pmt6835, nagi_mt6835_stats_t *pstats) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pstats == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+#if NAGI_MT6835_ENABLE_STATS
+  // Copy again when an update ran in between, back off when we interrupted one.
+  for (;;) {
+    const uint32_t seq = pmt6835->stats_seq;
+    if (seq & 1u) {
+      return NAGI_MT6835_ERROR;
+    }
+    *pstats = pmt6835->stats;
+    if (pmt6835->stats_seq == seq) {
+      return NAGI_MT6835_OK;
+    }
+  }
+#else
+  memset(pstats, 0, sizeof(*pstats));
+  return NAGI_MT6835_ERROR;
+#endif
+}
+
+nagi_mt6835_error_t nagi_mt6835_reset_stats(nagi_mt6835_t *pmt6835) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+#if NAGI_MT6835_ENABLE_STATS
+  static const nagi_mt6835_stats_t zero_stats;
+
+  if (pmt6835->stats_seq & 1u) {
+    return NAGI_MT6835_ERROR;
+  }
+  mt6835_stats_begin(pmt6835);
+  pmt6835->stats = zero_stats;
+  mt6835_stats_end(pmt6835);
+
+  return NAGI_MT6835_OK;
+#else
+  return NAGI_MT6835_ERROR;
+#endif
 }
 
 nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_begin(nagi_mt6835_t *pmt6835, uint8_t *tx_data, size_t tx_size) {
@@ -533,10 +1302,8 @@ nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_begin(nagi_mt6835_t *pmt6
     return NAGI_MT6835_INVALID_ARGUMENT;
   }
 
-  pmt6835->data_frame.cmd = NAGI_MT6835_CMD_CONTINUE;
-  pmt6835->data_frame.reg = NAGI_MT6835_REG_ANGLE3;
-  tx_data[0] = pmt6835->data_frame.pack & 0xFF;
-  tx_data[1] = (pmt6835->data_frame.pack >> 8) & 0xFF;
+  tx_data[0] = nagi_mt6835_continuous_read_tx[0];
+  tx_data[1] = nagi_mt6835_continuous_read_tx[1];
 
   pmt6835->is_custom_continuous_reading = true;
 
@@ -548,6 +1315,29 @@ nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end(
   const uint8_t *rx_data,
   size_t rx_size,
   float *pangle
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pangle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_custom_continuous_read_end_raw(pmt6835, rx_data, rx_size, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  *pangle = nagi_mt6835_raw_to_rad_f32(raw_angle);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end_raw(
+  nagi_mt6835_t *pmt6835,
+  const uint8_t *rx_data,
+  size_t rx_size,
+  uint32_t *praw_angle
 ) {
   if (pmt6835 == NULL) {
     return NAGI_MT6835_HANDLE_NULL;
@@ -555,7 +1345,7 @@ nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end(
   if (rx_data == NULL) {
     return NAGI_MT6835_POINTER_NULL;
   }
-  if (pangle == NULL) {
+  if (praw_angle == NULL) {
     return NAGI_MT6835_POINTER_NULL;
   }
   if (pmt6835->enable_crc_check && rx_size < 6) {
@@ -564,19 +1354,281 @@ nagi_mt6835_error_t nagi_mt6835_custom_continuous_read_end(
     return NAGI_MT6835_INVALID_ARGUMENT;
   }
 
-  pmt6835->warning = rx_data[4] & 0x07;
-  if (pmt6835->enable_crc_check) {
-    if (crc_table(rx_data + 2, 3) != rx_data[5]) {
-      pmt6835->crc_res = false;
-      return NAGI_MT6835_CRC_CHECK_FAILED;
+  pmt6835->angle_flags = NAGI_MT6835_ANGLE_FLAG_NONE;
+  nagi_mt6835_error_t err = mt6835_decode_angle(pmt6835, rx_data + 2, praw_angle);
+  err = mt6835_angle_fallback(pmt6835, err, praw_angle);
+  mt6835_publish_sample(pmt6835, err, *praw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_CONTINUOUS_READ, err);
+  }
+
+  pmt6835->is_custom_continuous_reading = false;
+
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_CONTINUOUS_READ, NAGI_MT6835_OK);
+}
+
+/// @brief Reset an asynchronous request and encode its frame.
+/// @param[out] preq request.
+/// @param[in] op operation.
+/// @param[in] cmd command.
+/// @param[in] reg register address.
+/// @param[in] data data byte.
+/// @param[in] size frame size.
+static void mt6835_async_prepare(
+  nagi_mt6835_async_req_t *preq,
+  nagi_mt6835_async_op_enum_t op,
+  nagi_mt6835_cmd_enum_t cmd,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t data,
+  size_t size
+) {
+  memset(preq->tx_data, 0, sizeof(preq->tx_data));
+  memset(preq->rx_data, 0, sizeof(preq->rx_data));
+  mt6835_encode_frame(preq->tx_data, cmd, reg, data);
+
+  preq->op = op;
+  preq->reg = reg;
+  preq->data = data;
+  preq->raw_angle = 0;
+  preq->warning = NAGI_MT6835_WARN_NONE;
+  preq->result = NAGI_MT6835_OK;
+  preq->state = NAGI_MT6835_ASYNC_STATE_IDLE;
+  preq->size = size;
+  preq->next = NULL;
+}
+
+/// @brief Start the request at the head of the queue.
+/// @param[in] pmt6835 mt6835 handle.
+/// @return transfer start error code.
+static int mt6835_async_start_head(nagi_mt6835_t *pmt6835) {
+  nagi_mt6835_async_req_t *preq = pmt6835->async_head;
+
+  preq->state = NAGI_MT6835_ASYNC_STATE_IN_FLIGHT;
+  mt6835_chip_select(pmt6835, true);
+#if NAGI_MT6835_ENABLE_STATS
+  pmt6835->async_start_cycle = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+#endif
+  if (pmt6835->start_transfer_ctx_fn != NULL) {
+    return pmt6835->start_transfer_ctx_fn(pmt6835->user_ctx, preq->tx_data, preq->rx_data, preq->size);
+  }
+  return pmt6835->start_transfer_fn(preq->tx_data, preq->rx_data, preq->size);
+}
+
+/// @brief Dequeue and complete the request at the head of the queue.
+/// @param[in] pmt6835 mt6835 handle.
+/// @param[in] transfer_err transfer error code.
+/// @return request result.
+static nagi_mt6835_error_t mt6835_async_finish_head(nagi_mt6835_t *pmt6835, int transfer_err) {
+  nagi_mt6835_async_req_t *preq = pmt6835->async_head;
+
+#if NAGI_MT6835_ENABLE_STATS
+  const uint32_t stop = pmt6835->cycle_counter_fn != NULL ? pmt6835->cycle_counter_fn() : 0;
+  mt6835_stats_transfer(pmt6835, preq->size, stop - pmt6835->async_start_cycle);
+#endif
+  mt6835_chip_select(pmt6835, false);
+  pmt6835->async_head = preq->next;
+  if (pmt6835->async_head == NULL) {
+    pmt6835->async_tail = NULL;
+  }
+  preq->next = NULL;
+  preq->result = (nagi_mt6835_error_t)transfer_err;
+
+  return nagi_mt6835_async_complete(pmt6835, preq);
+}
+
+/// @brief Start queued requests until one is running.
+/// @note A transport may complete synchronously from inside the start function.
+/// @param[in] pmt6835 mt6835 handle.
+static void mt6835_async_kick(nagi_mt6835_t *pmt6835) {
+  while (pmt6835->async_head != NULL && pmt6835->async_head->state == NAGI_MT6835_ASYNC_STATE_QUEUED) {
+    nagi_mt6835_async_req_t *preq = pmt6835->async_head;
+    int err = mt6835_async_start_head(pmt6835);
+    if (err == NAGI_MT6835_OK || pmt6835->async_head != preq || preq->state != NAGI_MT6835_ASYNC_STATE_IN_FLIGHT) {
+      return;
     }
-    pmt6835->crc_res = true;
+    // Start failed without a completion, fail this request and go on with the next one.
+    mt6835_async_finish_head(pmt6835, err);
+  }
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_prepare_get_raw_angle(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
   }
 
-  uint32_t raw_angle = (rx_data[2] << 13) | (rx_data[3] << 5) | (rx_data[4] >> 3);
-  *pangle = (float)(raw_angle * 2.996056226329803e-6);
+  const size_t size = pmt6835->enable_crc_check ? 6 : 5;
+  mt6835_async_prepare(preq, NAGI_MT6835_ASYNC_OP_GET_RAW_ANGLE, NAGI_MT6835_CMD_CONTINUE, NAGI_MT6835_REG_ANGLE3, 0, size);
 
-  pmt6835->is_custom_continuous_reading = false;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_prepare_read_reg(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq,
+  nagi_mt6835_reg_enum_t reg
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  mt6835_async_prepare(preq, NAGI_MT6835_ASYNC_OP_READ_REG, NAGI_MT6835_CMD_RD, reg, 0, 3);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_prepare_write_reg(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t data
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  mt6835_async_prepare(preq, NAGI_MT6835_ASYNC_OP_WRITE_REG, NAGI_MT6835_CMD_WR, reg, data, 3);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_prepare_auto_zero_angle(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  mt6835_async_prepare(preq, NAGI_MT6835_ASYNC_OP_AUTO_ZERO, NAGI_MT6835_CMD_ZERO, 0x00, 0, 3);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_prepare_program_eeprom(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
 
+  mt6835_async_prepare(preq, NAGI_MT6835_ASYNC_OP_PROGRAM_EEPROM, NAGI_MT6835_CMD_EEPROM, 0x00, 0, 3);
   return NAGI_MT6835_OK;
-}
\ No newline at end of file
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_complete(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  nagi_mt6835_error_t err = preq->result;
+  if (preq->op == NAGI_MT6835_ASYNC_OP_AUTO_ZERO) {
+    // The chip rewrites the zero registers, a partly clocked command may still have run.
+    pmt6835->shadow_valid &= ~((1u << NAGI_MT6835_REG_ZERO2) | (1u << NAGI_MT6835_REG_ZERO1));
+  }
+  if (err == NAGI_MT6835_OK) {
+    switch (preq->op) {
+      case NAGI_MT6835_ASYNC_OP_GET_RAW_ANGLE:
+        pmt6835->angle_flags = NAGI_MT6835_ANGLE_FLAG_NONE;
+        err = mt6835_decode_angle(pmt6835, &preq->rx_data[2], &preq->raw_angle);
+        preq->warning = pmt6835->warning;
+        mt6835_publish_sample(pmt6835, err, preq->raw_angle);
+        break;
+      case NAGI_MT6835_ASYNC_OP_READ_REG:
+        preq->data = preq->rx_data[2];
+        if (mt6835_shadow_cacheable(preq->reg) && (pmt6835->shadow_valid & (1u << preq->reg))) {
+          pmt6835->shadow_regs[preq->reg - NAGI_MT6835_SHADOW_REG_FIRST] = preq->data;
+        }
+        break;
+      case NAGI_MT6835_ASYNC_OP_WRITE_REG:
+        if (mt6835_shadow_cacheable(preq->reg) && (pmt6835->shadow_valid & (1u << preq->reg))) {
+          pmt6835->shadow_regs[preq->reg - NAGI_MT6835_SHADOW_REG_FIRST] = preq->data;
+        }
+        break;
+      case NAGI_MT6835_ASYNC_OP_AUTO_ZERO:
+        err = preq->rx_data[2] == 0x55 ? NAGI_MT6835_OK : NAGI_MT6835_ERROR;
+        break;
+      case NAGI_MT6835_ASYNC_OP_PROGRAM_EEPROM:
+        err = preq->rx_data[2] == 0x55 ? NAGI_MT6835_OK : NAGI_MT6835_ERROR;
+        break;
+      default:
+        err = NAGI_MT6835_INVALID_ARGUMENT;
+        break;
+    }
+  } else if (preq->op == NAGI_MT6835_ASYNC_OP_WRITE_REG && mt6835_shadow_cacheable(preq->reg)) {
+    // Device state is unknown after a failed write.
+    pmt6835->shadow_valid &= ~(1u << preq->reg);
+  }
+
+  preq->result = err;
+  preq->state = NAGI_MT6835_ASYNC_STATE_DONE;
+  if (preq->done_fn != NULL) {
+    preq->done_fn(preq);
+  }
+
+  return MT6835_STATS_RESULT(pmt6835, NAGI_MT6835_STATS_API_ASYNC, err);
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_submit(nagi_mt6835_t *pmt6835, nagi_mt6835_async_req_t *preq) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if ((pmt6835->start_transfer_fn == NULL && pmt6835->start_transfer_ctx_fn == NULL) ||
+      preq->size == 0 || preq->size > NAGI_MT6835_ASYNC_FRAME_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (preq->state == NAGI_MT6835_ASYNC_STATE_QUEUED || preq->state == NAGI_MT6835_ASYNC_STATE_IN_FLIGHT) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  preq->result = NAGI_MT6835_OK;
+  preq->state = NAGI_MT6835_ASYNC_STATE_QUEUED;
+  preq->next = NULL;
+  if (pmt6835->async_head != NULL) {
+    pmt6835->async_tail->next = preq;
+    pmt6835->async_tail = preq;
+    return NAGI_MT6835_OK;
+  }
+
+  pmt6835->async_head = preq;
+  pmt6835->async_tail = preq;
+  mt6835_async_kick(pmt6835);
+
+  return preq->state == NAGI_MT6835_ASYNC_STATE_DONE ? preq->result : NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_async_transfer_done(nagi_mt6835_t *pmt6835, int transfer_err) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  nagi_mt6835_async_req_t *preq = pmt6835->async_head;
+  if (preq == NULL || preq->state != NAGI_MT6835_ASYNC_STATE_IN_FLIGHT) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  nagi_mt6835_error_t err = mt6835_async_finish_head(pmt6835, transfer_err);
+  mt6835_async_kick(pmt6835);
+
+  return err;
+}
+
+bool nagi_mt6835_async_idle(const nagi_mt6835_t *pmt6835) {
+  if (pmt6835 == NULL) {
+    return true;
+  }
+
+  return pmt6835->async_head == NULL;
+}
@@ -0,0 +1,397 @@
+#include "nagi_mt6835_batch.h"
+
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+/// CRC8 is linear and starts from 0, so the CRC of ANGLE3, ANGLE2, ANGLE1 is
+/// T[T[T[a3]] ^ T[T[a2]] ^ T[a1]], i.e. slice2[a3] ^ slice1[a2] ^ crc8[a1], no serial dependency.
+
+/// T[T[T[n]]], ANGLE3 contribution.
+static const uint8_t crc8_slice2_table[256] = {
+  0x00, 0x6b, 0xd6, 0xbd, 0xab, 0xc0, 0x7d, 0x16, 0x51, 0x3a, 0x87, 0xec, 0xfa, 0x91, 0x2c, 0x47,
+  0xa2, 0xc9, 0x74, 0x1f, 0x09, 0x62, 0xdf, 0xb4, 0xf3, 0x98, 0x25, 0x4e, 0x58, 0x33, 0x8e, 0xe5,
+  0x43, 0x28, 0x95, 0xfe, 0xe8, 0x83, 0x3e, 0x55, 0x12, 0x79, 0xc4, 0xaf, 0xb9, 0xd2, 0x6f, 0x04,
+  0xe1, 0x8a, 0x37, 0x5c, 0x4a, 0x21, 0x9c, 0xf7, 0xb0, 0xdb, 0x66, 0x0d, 0x1b, 0x70, 0xcd, 0xa6,
+  0x86, 0xed, 0x50, 0x3b, 0x2d, 0x46, 0xfb, 0x90, 0xd7, 0xbc, 0x01, 0x6a, 0x7c, 0x17, 0xaa, 0xc1,
+  0x24, 0x4f, 0xf2, 0x99, 0x8f, 0xe4, 0x59, 0x32, 0x75, 0x1e, 0xa3, 0xc8, 0xde, 0xb5, 0x08, 0x63,
+  0xc5, 0xae, 0x13, 0x78, 0x6e, 0x05, 0xb8, 0xd3, 0x94, 0xff, 0x42, 0x29, 0x3f, 0x54, 0xe9, 0x82,
+  0x67, 0x0c, 0xb1, 0xda, 0xcc, 0xa7, 0x1a, 0x71, 0x36, 0x5d, 0xe0, 0x8b, 0x9d, 0xf6, 0x4b, 0x20,
+  0x0b, 0x60, 0xdd, 0xb6, 0xa0, 0xcb, 0x76, 0x1d, 0x5a, 0x31, 0x8c, 0xe7, 0xf1, 0x9a, 0x27, 0x4c,
+  0xa9, 0xc2, 0x7f, 0x14, 0x02, 0x69, 0xd4, 0xbf, 0xf8, 0x93, 0x2e, 0x45, 0x53, 0x38, 0x85, 0xee,
+  0x48, 0x23, 0x9e, 0xf5, 0xe3, 0x88, 0x35, 0x5e, 0x19, 0x72, 0xcf, 0xa4, 0xb2, 0xd9, 0x64, 0x0f,
+  0xea, 0x81, 0x3c, 0x57, 0x41, 0x2a, 0x97, 0xfc, 0xbb, 0xd0, 0x6d, 0x06, 0x10, 0x7b, 0xc6, 0xad,
+  0x8d, 0xe6, 0x5b, 0x30, 0x26, 0x4d, 0xf0, 0x9b, 0xdc, 0xb7, 0x0a, 0x61, 0x77, 0x1c, 0xa1, 0xca,
+  0x2f, 0x44, 0xf9, 0x92, 0x84, 0xef, 0x52, 0x39, 0x7e, 0x15, 0xa8, 0xc3, 0xd5, 0xbe, 0x03, 0x68,
+  0xce, 0xa5, 0x18, 0x73, 0x65, 0x0e, 0xb3, 0xd8, 0x9f, 0xf4, 0x49, 0x22, 0x34, 0x5f, 0xe2, 0x89,
+  0x6c, 0x07, 0xba, 0xd1, 0xc7, 0xac, 0x11, 0x7a, 0x3d, 0x56, 0xeb, 0x80, 0x96, 0xfd, 0x40, 0x2b,
+};
+
+/// T[T[n]], ANGLE2 contribution.
+static const uint8_t crc8_slice1_table[256] = {
+  0x00, 0x15, 0x2a, 0x3f, 0x54, 0x41, 0x7e, 0x6b, 0xa8, 0xbd, 0x82, 0x97, 0xfc, 0xe9, 0xd6, 0xc3,
+  0x57, 0x42, 0x7d, 0x68, 0x03, 0x16, 0x29, 0x3c, 0xff, 0xea, 0xd5, 0xc0, 0xab, 0xbe, 0x81, 0x94,
+  0xae, 0xbb, 0x84, 0x91, 0xfa, 0xef, 0xd0, 0xc5, 0x06, 0x13, 0x2c, 0x39, 0x52, 0x47, 0x78, 0x6d,
+  0xf9, 0xec, 0xd3, 0xc6, 0xad, 0xb8, 0x87, 0x92, 0x51, 0x44, 0x7b, 0x6e, 0x05, 0x10, 0x2f, 0x3a,
+  0x5b, 0x4e, 0x71, 0x64, 0x0f, 0x1a, 0x25, 0x30, 0xf3, 0xe6, 0xd9, 0xcc, 0xa7, 0xb2, 0x8d, 0x98,
+  0x0c, 0x19, 0x26, 0x33, 0x58, 0x4d, 0x72, 0x67, 0xa4, 0xb1, 0x8e, 0x9b, 0xf0, 0xe5, 0xda, 0xcf,
+  0xf5, 0xe0, 0xdf, 0xca, 0xa1, 0xb4, 0x8b, 0x9e, 0x5d, 0x48, 0x77, 0x62, 0x09, 0x1c, 0x23, 0x36,
+  0xa2, 0xb7, 0x88, 0x9d, 0xf6, 0xe3, 0xdc, 0xc9, 0x0a, 0x1f, 0x20, 0x35, 0x5e, 0x4b, 0x74, 0x61,
+  0xb6, 0xa3, 0x9c, 0x89, 0xe2, 0xf7, 0xc8, 0xdd, 0x1e, 0x0b, 0x34, 0x21, 0x4a, 0x5f, 0x60, 0x75,
+  0xe1, 0xf4, 0xcb, 0xde, 0xb5, 0xa0, 0x9f, 0x8a, 0x49, 0x5c, 0x63, 0x76, 0x1d, 0x08, 0x37, 0x22,
+  0x18, 0x0d, 0x32, 0x27, 0x4c, 0x59, 0x66, 0x73, 0xb0, 0xa5, 0x9a, 0x8f, 0xe4, 0xf1, 0xce, 0xdb,
+  0x4f, 0x5a, 0x65, 0x70, 0x1b, 0x0e, 0x31, 0x24, 0xe7, 0xf2, 0xcd, 0xd8, 0xb3, 0xa6, 0x99, 0x8c,
+  0xed, 0xf8, 0xc7, 0xd2, 0xb9, 0xac, 0x93, 0x86, 0x45, 0x50, 0x6f, 0x7a, 0x11, 0x04, 0x3b, 0x2e,
+  0xba, 0xaf, 0x90, 0x85, 0xee, 0xfb, 0xc4, 0xd1, 0x12, 0x07, 0x38, 0x2d, 0x46, 0x53, 0x6c, 0x79,
+  0x43, 0x56, 0x69, 0x7c, 0x17, 0x02, 0x3d, 0x28, 0xeb, 0xfe, 0xc1, 0xd4, 0xbf, 0xaa, 0x95, 0x80,
+  0x14, 0x01, 0x3e, 0x2b, 0x40, 0x55, 0x6a, 0x7f, 0xbc, 0xa9, 0x96, 0x83, 0xe8, 0xfd, 0xc2, 0xd7,
+};
+
+#if defined(__SSSE3__)
+/// High nibble tables, table[n << 4] for n = 0 - 15. Low nibble tables are the first 16 entries.
+static const uint8_t crc8_slice2_hi_table[16] = {
+  0x00, 0xa2, 0x43, 0xe1, 0x86, 0x24, 0xc5, 0x67, 0x0b, 0xa9, 0x48, 0xea, 0x8d, 0x2f, 0xce, 0x6c,
+};
+
+static const uint8_t crc8_slice1_hi_table[16] = {
+  0x00, 0x57, 0xae, 0xf9, 0x5b, 0x0c, 0xf5, 0xa2, 0xb6, 0xe1, 0x18, 0x4f, 0xed, 0xba, 0x43, 0x14,
+};
+
+static const uint8_t crc8_hi_table[16] = {
+  0x00, 0x70, 0xe0, 0x90, 0xc7, 0xb7, 0x27, 0x57, 0x89, 0xf9, 0x69, 0x19, 0x4e, 0x3e, 0xae, 0xde,
+};
+
+/// pshufb masks gathering frame byte 2 + j of 16 frames from the k-th 16-byte chunk.
+static const uint8_t frame_shuffle_table[4][6][16] = {
+  {
+    {0x02, 0x08, 0x0e, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x04, 0x0a, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x06, 0x0c, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x08, 0x0e, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x04, 0x0a, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x06, 0x0c},
+  },
+  {
+    {0x03, 0x09, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x05, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x05, 0x0b, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0d},
+  },
+  {
+    {0x04, 0x0a, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x00, 0x06, 0x0c, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x08, 0x0e, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x04, 0x0a, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x06, 0x0c, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x08, 0x0e},
+  },
+  {
+    {0x05, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x01, 0x07, 0x0d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x05, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0d, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0f},
+  },
+};
+
+/// @brief Decode 16 frames with SSSE3.
+/// @param frames 16 frames.
+/// @param raw_angles raw angles, 16 entries, NULL if not needed.
+/// @param warnings warnings, 16 entries, NULL if not needed.
+/// @param crc_pass CRC pass flags, 16 entries, NULL if not needed.
+/// @return CRC pass mask, bit n is frame n.
+static uint32_t batch_decode_block(
+  const uint8_t *frames,
+  uint32_t *raw_angles,
+  uint8_t *warnings,
+  uint8_t *crc_pass
+) {
+  __m128i chunk[6];
+  for (size_t k = 0; k < 6; k++) {
+    chunk[k] = _mm_loadu_si128((const __m128i *)(frames + k * 16));
+  }
+
+  // b[0] - b[3]: ANGLE3, ANGLE2, ANGLE1, CRC of the 16 frames.
+  __m128i b[4];
+  for (size_t j = 0; j < 4; j++) {
+    b[j] = _mm_setzero_si128();
+    for (size_t k = 0; k < 6; k++) {
+      const __m128i mask = _mm_loadu_si128((const __m128i *)frame_shuffle_table[j][k]);
+      b[j] = _mm_or_si128(b[j], _mm_shuffle_epi8(chunk[k], mask));
+    }
+  }
+
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i lo3 = _mm_and_si128(b[0], nibble);
+  const __m128i hi3 = _mm_and_si128(_mm_srli_epi16(b[0], 4), nibble);
+  const __m128i lo2 = _mm_and_si128(b[1], nibble);
+  const __m128i hi2 = _mm_and_si128(_mm_srli_epi16(b[1], 4), nibble);
+  const __m128i lo1 = _mm_and_si128(b[2], nibble);
+  const __m128i hi1 = _mm_and_si128(_mm_srli_epi16(b[2], 4), nibble);
+
+  __m128i crc = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)crc8_slice2_table), lo3);
+  crc = _mm_xor_si128(crc, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)crc8_slice2_hi_table), hi3));
+  crc = _mm_xor_si128(crc, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)crc8_slice1_table), lo2));
+  crc = _mm_xor_si128(crc, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)crc8_slice1_hi_table), hi2));
+  crc = _mm_xor_si128(crc, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)nagi_mt6835_crc8_table), lo1));
+  crc = _mm_xor_si128(crc, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)crc8_hi_table), hi1));
+
+  if (raw_angles != NULL) {
+    // (ANGLE3 << 16 | ANGLE2 << 8 | ANGLE1) >> 3 per 32-bit lane.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo16_l = _mm_unpacklo_epi8(b[2], b[1]);
+    const __m128i lo16_h = _mm_unpackhi_epi8(b[2], b[1]);
+    const __m128i hi16_l = _mm_unpacklo_epi8(b[0], zero);
+    const __m128i hi16_h = _mm_unpackhi_epi8(b[0], zero);
+    _mm_storeu_si128((__m128i *)(raw_angles + 0), _mm_srli_epi32(_mm_unpacklo_epi16(lo16_l, hi16_l), 3));
+    _mm_storeu_si128((__m128i *)(raw_angles + 4), _mm_srli_epi32(_mm_unpackhi_epi16(lo16_l, hi16_l), 3));
+    _mm_storeu_si128((__m128i *)(raw_angles + 8), _mm_srli_epi32(_mm_unpacklo_epi16(lo16_h, hi16_h), 3));
+    _mm_storeu_si128((__m128i *)(raw_angles + 12), _mm_srli_epi32(_mm_unpackhi_epi16(lo16_h, hi16_h), 3));
+  }
+  if (warnings != NULL) {
+    _mm_storeu_si128((__m128i *)warnings, _mm_and_si128(b[2], _mm_set1_epi8(0x07)));
+  }
+
+  const __m128i pass = _mm_cmpeq_epi8(crc, b[3]);
+  if (crc_pass != NULL) {
+    _mm_storeu_si128((__m128i *)crc_pass, _mm_and_si128(pass, _mm_set1_epi8(0x01)));
+  }
+
+  return (uint32_t)_mm_movemask_epi8(pass);
+}
+
+#define BATCH_BLOCK_FRAMES (16)
+#define BATCH_KERNEL_NAME  "ssse3"
+#else
+#define BATCH_BLOCK_FRAMES (0)
+#define BATCH_KERNEL_NAME  "slice3"
+#endif
+
+/// @brief Decode the raw angle of one frame.
+/// @param frame frame.
+/// @return raw angle.
+static uint32_t batch_raw_angle(const uint8_t *frame) {
+  return ((uint32_t)frame[2] << 13) | ((uint32_t)frame[3] << 5) | ((uint32_t)frame[4] >> 3);
+}
+
+/// @brief Check one frame with the slice-by-3 tables.
+/// @param frame frame, NAGI_MT6835_FRAME_SIZE bytes.
+/// @return true if the CRC passed.
+static bool batch_check_frame(const uint8_t *frame) {
+  return (crc8_slice2_table[frame[2]] ^ crc8_slice1_table[frame[3]] ^ nagi_mt6835_crc8_table[frame[4]]) == frame[5];
+}
+
+/// @brief Decode contiguous frames into the output arrays.
+/// @param frames frames.
+/// @param frame_size frame size, 5 without CRC or NAGI_MT6835_FRAME_SIZE.
+/// @param count frame count.
+/// @param raw_angles raw angles.
+/// @param warnings warnings.
+/// @param crc_pass CRC pass flags.
+static void batch_decode_frames(
+  const uint8_t *frames,
+  size_t frame_size,
+  size_t count,
+  uint32_t *raw_angles,
+  uint8_t *warnings,
+  uint8_t *crc_pass
+) {
+  size_t i = 0;
+#if BATCH_BLOCK_FRAMES > 0
+  if (frame_size == NAGI_MT6835_FRAME_SIZE) {
+    for (; i + BATCH_BLOCK_FRAMES <= count; i += BATCH_BLOCK_FRAMES) {
+      batch_decode_block(frames + i * frame_size, raw_angles + i, warnings + i, crc_pass + i);
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    const uint8_t *frame = frames + i * frame_size;
+    raw_angles[i] = batch_raw_angle(frame);
+    warnings[i] = frame[4] & 0x07;
+    crc_pass[i] = frame_size == NAGI_MT6835_FRAME_SIZE ? batch_check_frame(frame) : 1;
+  }
+}
+
+/// @brief Count set bits.
+/// @param value value.
+/// @return set bit count.
+static size_t batch_popcount(uint32_t value) {
+  value = value - ((value >> 1) & 0x55555555);
+  value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+  value = (value + (value >> 4)) & 0x0F0F0F0F;
+  return (size_t)((value * 0x01010101) >> 24);
+}
+
+uint8_t nagi_mt6835_crc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0x00;
+
+  for (size_t i = 0; i < len; i++) {
+    crc = nagi_mt6835_crc8_table[crc ^ data[i]];
+  }
+
+  return crc;
+}
+
+nagi_mt6835_error_t nagi_mt6835_batch_check_frames(
+  const uint8_t *frames,
+  size_t count,
+  uint32_t *pass_bitmap,
+  uint32_t *raw_angles,
+  size_t *ppass_count
+) {
+  if (frames == NULL || pass_bitmap == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  const size_t words = NAGI_MT6835_BATCH_BITMAP_WORDS(count);
+  memset(pass_bitmap, 0, words * sizeof(*pass_bitmap));
+
+  size_t i = 0;
+#if BATCH_BLOCK_FRAMES > 0
+  for (; i + BATCH_BLOCK_FRAMES <= count; i += BATCH_BLOCK_FRAMES) {
+    const uint32_t mask = batch_decode_block(
+      frames + i * NAGI_MT6835_FRAME_SIZE,
+      raw_angles != NULL ? raw_angles + i : NULL,
+      NULL,
+      NULL
+    );
+    pass_bitmap[i / 32] |= mask << (i % 32);
+  }
+#endif
+  for (; i < count; i++) {
+    const uint8_t *frame = frames + i * NAGI_MT6835_FRAME_SIZE;
+    if (raw_angles != NULL) {
+      raw_angles[i] = batch_raw_angle(frame);
+    }
+    if (batch_check_frame(frame)) {
+      pass_bitmap[i / 32] |= (uint32_t)1 << (i % 32);
+    }
+  }
+
+  if (ppass_count != NULL) {
+    size_t pass_count = 0;
+    for (size_t w = 0; w < words; w++) {
+      pass_count += batch_popcount(pass_bitmap[w]);
+    }
+    *ppass_count = pass_count;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_batch_ring_init(
+  nagi_mt6835_batch_ring_t *pring,
+  const uint8_t *buffer,
+  size_t frame_count,
+  size_t frame_size
+) {
+  if (pring == NULL || buffer == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (frame_count == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (frame_size != NAGI_MT6835_FRAME_SIZE && frame_size != NAGI_MT6835_FRAME_SIZE - 1) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  pring->buffer = buffer;
+  pring->frame_count = frame_count;
+  pring->frame_size = frame_size;
+  pring->read_index = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_batch_ring_decode(
+  nagi_mt6835_batch_ring_t *pring,
+  size_t write_index,
+  size_t max_count,
+  uint32_t *raw_angles,
+  uint8_t *warnings,
+  uint8_t *crc_pass,
+  size_t *pcount
+) {
+  if (pring == NULL || raw_angles == NULL || warnings == NULL || crc_pass == NULL || pcount == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (write_index >= pring->frame_count) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  size_t count = (write_index + pring->frame_count - pring->read_index) % pring->frame_count;
+  if (count > max_count) {
+    count = max_count;
+  }
+
+  // At most two contiguous runs, up to the end of the buffer and from its start.
+  size_t first = pring->frame_count - pring->read_index;
+  if (first > count) {
+    first = count;
+  }
+  batch_decode_frames(
+    pring->buffer + pring->read_index * pring->frame_size,
+    pring->frame_size,
+    first,
+    raw_angles,
+    warnings,
+    crc_pass
+  );
+  batch_decode_frames(
+    pring->buffer,
+    pring->frame_size,
+    count - first,
+    raw_angles + first,
+    warnings + first,
+    crc_pass + first
+  );
+
+  pring->read_index = (pring->read_index + count) % pring->frame_count;
+  *pcount = count;
+
+  return NAGI_MT6835_OK;
+}
+
+const char *nagi_mt6835_batch_kernel_name(void) {
+  return BATCH_KERNEL_NAME;
+}
+
+uint32_t nagi_mt6835_batch_verify_kernel(void) {
+  // 256 frames share ANGLE3 and ANGLE2, ANGLE1 runs 0 - 255. Even passes carry the reference
+  // CRC, odd passes flip one CRC bit.
+  uint8_t frames[256 * NAGI_MT6835_FRAME_SIZE];
+  uint32_t pass_bitmap[NAGI_MT6835_BATCH_BITMAP_WORDS(256)];
+  uint32_t raw_angles[256];
+  uint32_t mismatches = 0;
+
+  for (uint32_t hi = 0; hi < 0x10000; hi++) {
+    for (uint32_t corrupt = 0; corrupt < 2; corrupt++) {
+      for (uint32_t lo = 0; lo < 256; lo++) {
+        uint8_t *frame = &frames[lo * NAGI_MT6835_FRAME_SIZE];
+        frame[0] = (uint8_t)(NAGI_MT6835_CMD_CONTINUE << 4);
+        frame[1] = NAGI_MT6835_REG_ANGLE3;
+        frame[2] = (uint8_t)(hi >> 8);
+        frame[3] = (uint8_t)hi;
+        frame[4] = (uint8_t)lo;
+        frame[5] = (uint8_t)(nagi_mt6835_crc8(&frame[2], 3) ^ (corrupt << (lo & 7)));
+      }
+
+      nagi_mt6835_batch_check_frames(frames, 256, pass_bitmap, raw_angles, NULL);
+
+      for (uint32_t lo = 0; lo < 256; lo++) {
+        const bool pass = (pass_bitmap[lo / 32] >> (lo % 32)) & 1;
+        const uint32_t raw_angle = (hi << 5) | (lo >> 3);
+        if (pass != (corrupt == 0) || raw_angles[lo] != raw_angle) {
+          mismatches++;
+        }
+      }
+    }
+  }
+
+  return mismatches;
+}
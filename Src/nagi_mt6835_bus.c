@@ -0,0 +1,177 @@
+#include "nagi_mt6835_bus.h"
+
+#include <string.h>
+
+/// @brief Get the device of an angle slot.
+/// @param pbus bus handle.
+/// @param slot slot in the cycle.
+/// @param pdevice device index.
+/// @return true if the slot is an angle slot.
+static bool bus_angle_slot(const nagi_mt6835_bus_t *pbus, size_t slot, size_t *pdevice) {
+  if (pbus->config.policy == NAGI_MT6835_BUS_POLICY_ROUND_ROBIN) {
+    *pdevice = slot / 2;
+    return (slot % 2) == 0;
+  }
+
+  *pdevice = slot;
+  return slot < pbus->config.device_count;
+}
+
+/// @brief Run an angle slot.
+/// @param pbus bus handle.
+/// @param device device index.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t bus_run_angle(nagi_mt6835_bus_t *pbus, size_t device) {
+  nagi_mt6835_t *pmt6835 = pbus->config.devices[device];
+  nagi_mt6835_bus_sample_t *psample = &pbus->config.samples[device];
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, pbus->config.method, &raw_angle);
+  if (err == NAGI_MT6835_OK) {
+    psample->raw_angle = raw_angle;
+  }
+  psample->warning = pmt6835->warning;
+  psample->err = err;
+  psample->cycle = pbus->cycle;
+
+  return err;
+}
+
+/// @brief Run a config slot.
+/// @param pbus bus handle.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t bus_run_config(nagi_mt6835_bus_t *pbus) {
+  if (pbus->write_count == 0) {
+    return NAGI_MT6835_OK;
+  }
+
+  const nagi_mt6835_bus_write_t write = pbus->config.write_queue[pbus->write_head];
+  pbus->write_head = (pbus->write_head + 1) % pbus->config.write_queue_size;
+  pbus->write_count--;
+
+  nagi_mt6835_error_t err = nagi_mt6835_write_reg(pbus->config.devices[write.device], write.reg, write.data);
+  if (err != NAGI_MT6835_OK) {
+    pbus->write_errors++;
+  }
+
+  return err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_bus_init(nagi_mt6835_bus_t *pbus, const nagi_mt6835_bus_config_t *pconfig) {
+  if (pbus == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pconfig == NULL || pconfig->devices == NULL || pconfig->samples == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (pconfig->device_count == 0 || pconfig->device_count > 0xFF) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pconfig->write_queue_size > 0 && pconfig->write_queue == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  for (size_t i = 0; i < pconfig->device_count; i++) {
+    if (pconfig->devices[i] == NULL) {
+      return NAGI_MT6835_POINTER_NULL;
+    }
+  }
+
+  memset(pbus, 0, sizeof(*pbus));
+  pbus->config = *pconfig;
+
+  switch (pconfig->policy) {
+    case NAGI_MT6835_BUS_POLICY_PRIORITY:
+      pbus->slots_per_cycle = pconfig->device_count + pconfig->config_slots;
+      break;
+    case NAGI_MT6835_BUS_POLICY_ROUND_ROBIN:
+      pbus->slots_per_cycle = pconfig->device_count * 2;
+      break;
+    default:
+      return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  memset(pconfig->samples, 0, sizeof(*pconfig->samples) * pconfig->device_count);
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_bus_queue_write(
+  nagi_mt6835_bus_t *pbus,
+  uint8_t device,
+  nagi_mt6835_reg_enum_t reg,
+  uint8_t data
+) {
+  if (pbus == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (device >= pbus->config.device_count) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pbus->write_count >= pbus->config.write_queue_size) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  const size_t tail = (pbus->write_head + pbus->write_count) % pbus->config.write_queue_size;
+  pbus->config.write_queue[tail].device = device;
+  pbus->config.write_queue[tail].reg = reg;
+  pbus->config.write_queue[tail].data = data;
+  pbus->write_count++;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_bus_poll(nagi_mt6835_bus_t *pbus) {
+  if (pbus == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  size_t device = 0;
+  nagi_mt6835_error_t err = bus_angle_slot(pbus, pbus->slot, &device)
+    ? bus_run_angle(pbus, device)
+    : bus_run_config(pbus);
+
+  pbus->slot++;
+  if (pbus->slot >= pbus->slots_per_cycle) {
+    pbus->slot = 0;
+    pbus->cycle++;
+  }
+
+  return err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_bus_poll_cycle(nagi_mt6835_bus_t *pbus) {
+  if (pbus == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  nagi_mt6835_error_t first_err = NAGI_MT6835_OK;
+  const uint32_t cycle = pbus->cycle;
+  while (pbus->cycle == cycle) {
+    size_t device = 0;
+    const bool angle_slot = bus_angle_slot(pbus, pbus->slot, &device);
+    nagi_mt6835_error_t err = nagi_mt6835_bus_poll(pbus);
+    if (angle_slot && err != NAGI_MT6835_OK && first_err == NAGI_MT6835_OK) {
+      first_err = err;
+    }
+  }
+
+  return first_err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_bus_get_sample(
+  const nagi_mt6835_bus_t *pbus,
+  uint8_t device,
+  nagi_mt6835_bus_sample_t *psample
+) {
+  if (pbus == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (psample == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (device >= pbus->config.device_count) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  *psample = pbus->config.samples[device];
+  return NAGI_MT6835_OK;
+}
@@ -0,0 +1,252 @@
+#include "nagi_mt6835_calib.h"
+
+#include <string.h>
+#include <math.h>
+
+#define CALIB_ANGLE_MASK (NAGI_MT6835_ANGLE_RESOLUTION - 1)
+#define CALIB_TWO_PI     (6.283185307179586)
+
+/// @brief Signed shortest difference of two raw angles.
+/// @param a raw angle.
+/// @param b raw angle.
+/// @return a - b in raw counts, -half turn to half turn - 1.
+static int32_t calib_diff(uint32_t a, uint32_t b) {
+  return (int32_t)((a - b) << 11) >> 11;
+}
+
+/// @brief Remove the mean of the node values and store them in the table.
+/// @param pcalib calibration.
+/// @param nodes node values in raw counts, size entries.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t calib_store(nagi_mt6835_calib_t *pcalib, const int64_t *nodes) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < pcalib->size; i++) {
+    sum += nodes[i];
+  }
+  const int64_t mean = sum / (int64_t)pcalib->size;
+
+  for (size_t i = 0; i < pcalib->size; i++) {
+    const int64_t value = nodes[i] - mean;
+    if (value < INT16_MIN || value > INT16_MAX) {
+      return NAGI_MT6835_INVALID_ARGUMENT;
+    }
+  }
+  for (size_t i = 0; i < pcalib->size; i++) {
+    pcalib->table[i] = (int16_t)(nodes[i] - mean);
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_calib_init(nagi_mt6835_calib_t *pcalib, int16_t *table, size_t size) {
+  if (pcalib == NULL || table == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (size < NAGI_MT6835_CALIB_SIZE_MIN || size > NAGI_MT6835_CALIB_SIZE_MAX || (size & (size - 1)) != 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  uint32_t shift = 21;
+  for (size_t n = size; n > 1; n >>= 1) {
+    shift--;
+  }
+
+  pcalib->table = table;
+  pcalib->size = size;
+  pcalib->shift = shift;
+  memset(table, 0, size * sizeof(*table));
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_calib_sweep_reference(
+  const uint32_t *measured,
+  size_t count,
+  uint32_t *reference
+) {
+  if (measured == NULL || reference == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (count < 2) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  // The error repeats every turn, so the travel between two equal measured angles is exactly whole
+  // turns. Speed comes from the last whole turn crossing, not a line fit the error would tilt.
+  int64_t last = 0;
+  for (size_t i = 1; i < count; i++) {
+    last += calib_diff(measured[i], measured[i - 1]);
+  }
+  const int64_t turns = (last >= 0 ? last : -last) / NAGI_MT6835_ANGLE_RESOLUTION;
+  if (turns == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  const int64_t target = (last >= 0 ? turns : -turns) * NAGI_MT6835_ANGLE_RESOLUTION;
+
+  int64_t position = 0;
+  int64_t prev = 0;
+  double crossing = 0.0;
+  for (size_t i = 1; i < count; i++) {
+    position += calib_diff(measured[i], measured[i - 1]);
+    if ((target > 0 && position >= target) || (target < 0 && position <= target)) {
+      crossing = (double)(i - 1) + (double)(target - prev) / (double)(position - prev);
+      break;
+    }
+    prev = position;
+  }
+  const double slope = (double)target / crossing;
+
+  // Mean offset over the whole turns.
+  const size_t whole = (size_t)crossing;
+  double offset = 0.0;
+  position = 0;
+  for (size_t i = 0; i < whole; i++) {
+    if (i > 0) {
+      position += calib_diff(measured[i], measured[i - 1]);
+    }
+    offset += (double)position - slope * (double)i;
+  }
+  offset /= (double)whole;
+
+  for (size_t i = 0; i < count; i++) {
+    const int64_t travel = llround(offset + slope * (double)i);
+    reference[i] = (uint32_t)((int64_t)measured[0] + travel) & CALIB_ANGLE_MASK;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_calib_fit_linear(
+  nagi_mt6835_calib_t *pcalib,
+  const uint32_t *measured,
+  const uint32_t *reference,
+  size_t count,
+  int64_t *workspace
+) {
+  if (pcalib == NULL || measured == NULL || reference == NULL || workspace == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (count == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  const size_t size = pcalib->size;
+  int64_t *sums = workspace;
+  int64_t *counts = workspace + size;
+  memset(workspace, 0, 2 * size * sizeof(*workspace));
+
+  // Nearest entry. All samples may fall on one entry with errors up to half a turn, so the sums
+  // need 64 bits.
+  const uint32_t half = 1u << (pcalib->shift - 1);
+  for (size_t i = 0; i < count; i++) {
+    const size_t index = (((measured[i] & CALIB_ANGLE_MASK) + half) >> pcalib->shift) & (size - 1);
+    sums[index] += calib_diff(reference[i], measured[i]);
+    counts[index]++;
+  }
+
+  size_t first = size;
+  for (size_t i = 0; i < size; i++) {
+    if (counts[i] > 0) {
+      sums[i] = sums[i] >= 0
+        ? (sums[i] + counts[i] / 2) / counts[i]
+        : (sums[i] - counts[i] / 2) / counts[i];
+      if (first == size) {
+        first = i;
+      }
+    }
+  }
+  if (first == size) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  // Fill the gaps between filled entries, going round the turn.
+  size_t prev = first;
+  for (size_t step = 1; step <= size; step++) {
+    const size_t i = (first + step) % size;
+    if (counts[i] == 0) {
+      continue;
+    }
+    const size_t gap = (i + size - prev) % size;
+    const size_t span = gap == 0 ? size : gap;
+    for (size_t k = 1; k < span; k++) {
+      sums[(prev + k) % size] = sums[prev] + (sums[i] - sums[prev]) * (int64_t)k / (int64_t)span;
+    }
+    prev = i;
+  }
+
+  return calib_store(pcalib, sums);
+}
+
+nagi_mt6835_error_t nagi_mt6835_calib_fit_harmonic(
+  nagi_mt6835_calib_t *pcalib,
+  const uint32_t *measured,
+  const uint32_t *reference,
+  size_t count,
+  size_t harmonics
+) {
+  if (pcalib == NULL || measured == NULL || reference == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (count == 0 || harmonics == 0 || harmonics > NAGI_MT6835_CALIB_HARMONICS_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  double cos_sum[NAGI_MT6835_CALIB_HARMONICS_MAX] = {0};
+  double sin_sum[NAGI_MT6835_CALIB_HARMONICS_MAX] = {0};
+
+  for (size_t i = 0; i < count; i++) {
+    const double error = (double)calib_diff(reference[i], measured[i]);
+    const double phase = CALIB_TWO_PI * (double)(measured[i] & CALIB_ANGLE_MASK) / NAGI_MT6835_ANGLE_RESOLUTION;
+    const double c1 = cos(phase);
+    const double s1 = sin(phase);
+    // Higher harmonics by rotation, one cos / sin per sample.
+    double c = c1;
+    double s = s1;
+    for (size_t h = 0; h < harmonics; h++) {
+      cos_sum[h] += error * c;
+      sin_sum[h] += error * s;
+      const double next_c = c * c1 - s * s1;
+      s = s * c1 + c * s1;
+      c = next_c;
+    }
+  }
+
+  // The amplitude sum bounds every entry, check it before touching the table.
+  const double scale = 2.0 / (double)count;
+  double bound = 0.0;
+  for (size_t h = 0; h < harmonics; h++) {
+    cos_sum[h] *= scale;
+    sin_sum[h] *= scale;
+    bound += sqrt(cos_sum[h] * cos_sum[h] + sin_sum[h] * sin_sum[h]);
+  }
+  if (bound >= INT16_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  for (size_t i = 0; i < pcalib->size; i++) {
+    const double phase = CALIB_TWO_PI * (double)i / (double)pcalib->size;
+    double value = 0.0;
+    for (size_t h = 0; h < harmonics; h++) {
+      const double angle = phase * (double)(h + 1);
+      value += cos_sum[h] * cos(angle) + sin_sum[h] * sin(angle);
+    }
+    pcalib->table[i] = (int16_t)lround(value);
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_calib_attach(nagi_mt6835_t *pmt6835, const nagi_mt6835_calib_t *pcalib) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  if (pcalib == NULL) {
+    return nagi_mt6835_set_angle_correction(pmt6835, NULL, NULL);
+  }
+  return nagi_mt6835_set_angle_correction(pmt6835, nagi_mt6835_calib_correct, (void *)pcalib);
+}
+
+uint32_t nagi_mt6835_calib_correct(void *ctx, uint32_t raw_angle) {
+  return nagi_mt6835_calib_apply((const nagi_mt6835_calib_t *)ctx, raw_angle);
+}
@@ -0,0 +1,223 @@
+#include "nagi_mt6835_capture.h"
+
+#include <string.h>
+
+_Static_assert(sizeof(_Atomic uint32_t) == sizeof(uint32_t), "C++ sees the atomic words as uint32_t");
+
+/// @brief Store a little endian uint32_t.
+/// @param data destination.
+/// @param value value.
+static void capture_put_u32(uint8_t *data, uint32_t value) {
+  data[0] = (uint8_t)value;
+  data[1] = (uint8_t)(value >> 8);
+  data[2] = (uint8_t)(value >> 16);
+  data[3] = (uint8_t)(value >> 24);
+}
+
+/// @brief Load a little endian uint32_t.
+/// @param data source.
+/// @return value.
+static uint32_t capture_get_u32(const uint8_t *data) {
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_init(
+  nagi_mt6835_capture_t *pcapture,
+  uint8_t *storage,
+  size_t storage_size,
+  nagi_mt6835_capture_format_enum_t format,
+  uint32_t timer_hz
+) {
+  if (pcapture == NULL || storage == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (format != NAGI_MT6835_CAPTURE_FORMAT_8 && format != NAGI_MT6835_CAPTURE_FORMAT_12) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  // Power of two capacity keeps the free running counters valid across their wrap.
+  const size_t capacity = storage_size / (size_t)format;
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0 || capacity > 0x80000000u) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  pcapture->storage = storage;
+  pcapture->capacity = (uint32_t)capacity;
+  pcapture->format = format;
+  pcapture->timer_hz = timer_hz;
+  atomic_init(&pcapture->head, 0);
+  atomic_init(&pcapture->tail, 0);
+  atomic_init(&pcapture->overruns, 0);
+  pcapture->gap = false;
+  pcapture->last_timestamp = 0;
+  pcapture->timestamp_hi = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_capture_t *pcapture) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  if (pcapture == NULL) {
+    return nagi_mt6835_remove_sample_hook(pmt6835, nagi_mt6835_capture_push, NULL);
+  }
+  return nagi_mt6835_add_sample_hook(pmt6835, nagi_mt6835_capture_push, pcapture);
+}
+
+void nagi_mt6835_capture_push(void *ctx, const nagi_mt6835_sample_t *psample) {
+  nagi_mt6835_capture_t *pcapture = (nagi_mt6835_capture_t *)ctx;
+
+  // Keep the 64 bit time running even while the ring is full.
+  if (psample->timestamp < pcapture->last_timestamp) {
+    pcapture->timestamp_hi++;
+  }
+  pcapture->last_timestamp = psample->timestamp;
+
+  const uint32_t head = atomic_load_explicit(&pcapture->head, memory_order_relaxed);
+  const uint32_t tail = atomic_load_explicit(&pcapture->tail, memory_order_acquire);
+  if (head - tail >= pcapture->capacity) {
+    atomic_store_explicit(
+      &pcapture->overruns,
+      atomic_load_explicit(&pcapture->overruns, memory_order_relaxed) + 1,
+      memory_order_relaxed
+    );
+    pcapture->gap = true;
+    return;
+  }
+
+  uint32_t word = (psample->raw_angle & (NAGI_MT6835_ANGLE_RESOLUTION - 1)) |
+                  ((uint32_t)(psample->warning & 0x07) << NAGI_MT6835_CAPTURE_WORD_WARNING_SHIFT) |
+                  ((uint32_t)(psample->angle_flags & 0x1F) << NAGI_MT6835_CAPTURE_WORD_FLAGS_SHIFT);
+  if (psample->crc_ok) {
+    word |= NAGI_MT6835_CAPTURE_WORD_CRC_OK;
+  }
+  if (pcapture->gap) {
+    word |= NAGI_MT6835_CAPTURE_WORD_GAP;
+    pcapture->gap = false;
+  }
+
+  uint8_t *record = pcapture->storage + (size_t)(head & (pcapture->capacity - 1)) * (size_t)pcapture->format;
+  capture_put_u32(record, psample->timestamp);
+  if (pcapture->format == NAGI_MT6835_CAPTURE_FORMAT_12) {
+    capture_put_u32(record + 4, pcapture->timestamp_hi);
+    capture_put_u32(record + 8, word);
+  } else {
+    capture_put_u32(record + 4, word);
+  }
+
+  atomic_store_explicit(&pcapture->head, head + 1, memory_order_release);
+}
+
+uint32_t nagi_mt6835_capture_count(nagi_mt6835_capture_t *pcapture) {
+  if (pcapture == NULL) {
+    return 0;
+  }
+
+  const uint32_t head = atomic_load_explicit(&pcapture->head, memory_order_acquire);
+  return head - atomic_load_explicit(&pcapture->tail, memory_order_relaxed);
+}
+
+uint32_t nagi_mt6835_capture_get_overruns(nagi_mt6835_capture_t *pcapture) {
+  if (pcapture == NULL) {
+    return 0;
+  }
+
+  return atomic_load_explicit(&pcapture->overruns, memory_order_relaxed);
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_write_header(const nagi_mt6835_capture_t *pcapture, uint8_t *data) {
+  if (pcapture == NULL || data == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  memset(data, 0, NAGI_MT6835_CAPTURE_HEADER_SIZE);
+  capture_put_u32(data, NAGI_MT6835_CAPTURE_MAGIC);
+  data[4] = NAGI_MT6835_CAPTURE_VERSION;
+  data[5] = (uint8_t)pcapture->format;
+  capture_put_u32(data + 8, pcapture->timer_hz);
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_drain(
+  nagi_mt6835_capture_t *pcapture,
+  uint8_t *data,
+  size_t size,
+  size_t *pwritten
+) {
+  if (pcapture == NULL || data == NULL || pwritten == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  const uint32_t tail = atomic_load_explicit(&pcapture->tail, memory_order_relaxed);
+  const uint32_t head = atomic_load_explicit(&pcapture->head, memory_order_acquire);
+  const size_t room = size / (size_t)pcapture->format;
+  const uint32_t count = (size_t)(head - tail) < room ? head - tail : (uint32_t)room;
+
+  // At most two runs, up to the end of the storage and from its start.
+  const uint32_t index = tail & (pcapture->capacity - 1);
+  const uint32_t first = count < pcapture->capacity - index ? count : pcapture->capacity - index;
+  const size_t record_size = (size_t)pcapture->format;
+  memcpy(data, pcapture->storage + (size_t)index * record_size, (size_t)first * record_size);
+  memcpy(data + (size_t)first * record_size, pcapture->storage, (size_t)(count - first) * record_size);
+
+  atomic_store_explicit(&pcapture->tail, tail + count, memory_order_release);
+  *pwritten = (size_t)count * record_size;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_parse_header(
+  const uint8_t *data,
+  size_t size,
+  nagi_mt6835_capture_format_enum_t *pformat,
+  uint32_t *ptimer_hz
+) {
+  if (data == NULL || pformat == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (size < NAGI_MT6835_CAPTURE_HEADER_SIZE ||
+      capture_get_u32(data) != NAGI_MT6835_CAPTURE_MAGIC ||
+      data[4] != NAGI_MT6835_CAPTURE_VERSION ||
+      (data[5] != NAGI_MT6835_CAPTURE_FORMAT_8 && data[5] != NAGI_MT6835_CAPTURE_FORMAT_12)) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  *pformat = (nagi_mt6835_capture_format_enum_t)data[5];
+  if (ptimer_hz != NULL) {
+    *ptimer_hz = capture_get_u32(data + 8);
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_capture_decode_record(
+  const uint8_t *data,
+  nagi_mt6835_capture_format_enum_t format,
+  nagi_mt6835_capture_record_t *precord
+) {
+  if (data == NULL || precord == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t word = 0;
+  if (format == NAGI_MT6835_CAPTURE_FORMAT_12) {
+    precord->timestamp = (uint64_t)capture_get_u32(data) | ((uint64_t)capture_get_u32(data + 4) << 32);
+    word = capture_get_u32(data + 8);
+  } else if (format == NAGI_MT6835_CAPTURE_FORMAT_8) {
+    precord->timestamp = capture_get_u32(data);
+    word = capture_get_u32(data + 4);
+  } else {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  precord->raw_angle = word & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  precord->warning = (nagi_mt6835_warning_t)((word >> NAGI_MT6835_CAPTURE_WORD_WARNING_SHIFT) & 0x07);
+  precord->crc_ok = (word & NAGI_MT6835_CAPTURE_WORD_CRC_OK) != 0;
+  precord->angle_flags = (uint8_t)((word >> NAGI_MT6835_CAPTURE_WORD_FLAGS_SHIFT) & 0x1F);
+  precord->gap = (word & NAGI_MT6835_CAPTURE_WORD_GAP) != 0;
+
+  return NAGI_MT6835_OK;
+}
@@ -0,0 +1,195 @@
+#include "nagi_mt6835_filter.h"
+
+#define FILTER_ANGLE_MASK (NAGI_MT6835_ANGLE_RESOLUTION - 1)
+
+/// @brief Signed shortest move between two raw angles.
+/// @param a raw angle.
+/// @param b reference raw angle.
+/// @return a - b in counts, -half turn to half turn - 1.
+static inline int32_t filter_delta(uint32_t a, uint32_t b) {
+  // Sign extend the 21-bit difference.
+  return (int32_t)((a - b) << 11) >> 11;
+}
+
+/// @brief Prime every stage with the first valid sample.
+/// @param pfilter filter.
+/// @param raw_angle raw angle.
+static void filter_prime(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle) {
+  pfilter->primed = true;
+  pfilter->last_accepted = raw_angle;
+  pfilter->reject_run = 0;
+  for (uint8_t i = 0; i < NAGI_MT6835_FILTER_MEDIAN_MAX; i++) {
+    pfilter->window[i] = raw_angle;
+  }
+  pfilter->window_index = 0;
+  pfilter->last_median = raw_angle;
+}
+
+/// @brief Count a rejected sample.
+/// @param pfilter filter.
+static inline void filter_reject(nagi_mt6835_filter_t *pfilter) {
+  pfilter->reject_count++;
+  if (pfilter->reject_run < UINT16_MAX) {
+    pfilter->reject_run++;
+  }
+}
+
+/// @brief Gate a valid sample.
+/// @param pfilter filter.
+/// @param raw_angle raw angle.
+/// @return gated sample.
+static uint32_t filter_gate(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle) {
+  if (pfilter->max_delta != 0) {
+    const int32_t delta = filter_delta(raw_angle, pfilter->last_accepted);
+    const uint32_t magnitude = (uint32_t)(delta < 0 ? -delta : delta);
+    // The shaft may have moved further for every sample held since the last accepted one.
+    const uint64_t allowed = (uint64_t)pfilter->max_delta * ((uint64_t)pfilter->reject_run + 1);
+
+    if (magnitude > allowed) {
+      if (pfilter->max_rejects == 0 || pfilter->reject_run < pfilter->max_rejects) {
+        filter_reject(pfilter);
+        return pfilter->last_accepted;
+      }
+      pfilter->relock_count++;
+    }
+  }
+
+  pfilter->last_accepted = raw_angle;
+  pfilter->reject_run = 0;
+  return raw_angle;
+}
+
+/// @brief Median of the window, relative to the last median so the window may straddle the wrap.
+/// @param pfilter filter.
+/// @param raw_angle newest gated sample.
+/// @return median raw angle.
+static uint32_t filter_median(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle) {
+  if (pfilter->median_size <= 1) {
+    return raw_angle;
+  }
+
+  pfilter->window[pfilter->window_index] = raw_angle;
+  pfilter->window_index = pfilter->window_index + 1 == pfilter->median_size ? 0 : pfilter->window_index + 1;
+
+  int32_t sorted[NAGI_MT6835_FILTER_MEDIAN_MAX];
+  for (uint8_t i = 0; i < pfilter->median_size; i++) {
+    // Insertion sort, at most NAGI_MT6835_FILTER_MEDIAN_MAX^2 / 2 compares.
+    const int32_t delta = filter_delta(pfilter->window[i], pfilter->last_median);
+    uint8_t j = i;
+    for (; j > 0 && sorted[j - 1] > delta; j--) {
+      sorted[j] = sorted[j - 1];
+    }
+    sorted[j] = delta;
+  }
+
+  pfilter->last_median = (pfilter->last_median + (uint32_t)sorted[pfilter->median_size / 2]) & FILTER_ANGLE_MASK;
+  return pfilter->last_median;
+}
+
+/// @brief Feed the average stage.
+/// @param pfilter filter.
+/// @param raw_angle median output.
+/// @param[out] praw_angle block mean, set when the block is complete.
+/// @return true when the block is complete.
+static bool filter_average(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle, uint32_t *praw_angle) {
+  if (pfilter->decimation <= 1) {
+    *praw_angle = raw_angle;
+    return true;
+  }
+
+  if (pfilter->block_count == 0) {
+    pfilter->block_ref = raw_angle;
+    pfilter->block_sum = 0;
+  } else {
+    pfilter->block_sum += filter_delta(raw_angle, pfilter->block_ref);
+  }
+  pfilter->block_count++;
+  if (pfilter->block_count < pfilter->decimation) {
+    return false;
+  }
+
+  // Round half away from zero.
+  const int32_t half = pfilter->decimation / 2;
+  const int32_t sum = pfilter->block_sum;
+  const int32_t mean = (sum + (sum < 0 ? -half : half)) / pfilter->decimation;
+  *praw_angle = (pfilter->block_ref + (uint32_t)mean) & FILTER_ANGLE_MASK;
+  pfilter->block_count = 0;
+  return true;
+}
+
+nagi_mt6835_error_t nagi_mt6835_filter_init(nagi_mt6835_filter_t *pfilter, const nagi_mt6835_filter_config_t *pconfig) {
+  if (pfilter == NULL || pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (pconfig->median_size > NAGI_MT6835_FILTER_MEDIAN_MAX ||
+      (pconfig->median_size > 1 && (pconfig->median_size & 1) == 0)) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pconfig->decimation > NAGI_MT6835_FILTER_DECIMATION_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  pfilter->median_size = pconfig->median_size;
+  pfilter->max_delta = pconfig->max_delta;
+  pfilter->max_rejects = pconfig->max_rejects;
+  pfilter->decimation = pconfig->decimation;
+  pfilter->reject_warnings = pconfig->reject_warnings;
+
+  return nagi_mt6835_filter_reset(pfilter);
+}
+
+nagi_mt6835_error_t nagi_mt6835_filter_reset(nagi_mt6835_filter_t *pfilter) {
+  if (pfilter == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  filter_prime(pfilter, 0);
+  pfilter->primed = false;
+  pfilter->block_ref = 0;
+  pfilter->block_sum = 0;
+  pfilter->block_count = 0;
+  pfilter->sample_count = 0;
+  pfilter->reject_count = 0;
+  pfilter->invalid_count = 0;
+  pfilter->relock_count = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+bool nagi_mt6835_filter_push(nagi_mt6835_filter_t *pfilter, uint32_t raw_angle, uint32_t *praw_angle) {
+  pfilter->sample_count++;
+  if (!pfilter->primed) {
+    filter_prime(pfilter, raw_angle);
+  }
+
+  const uint32_t gated = filter_gate(pfilter, raw_angle);
+  return filter_average(pfilter, filter_median(pfilter, gated), praw_angle);
+}
+
+bool nagi_mt6835_filter_push_invalid(nagi_mt6835_filter_t *pfilter, uint32_t *praw_angle) {
+  pfilter->sample_count++;
+  pfilter->invalid_count++;
+  if (!pfilter->primed) {
+    return false;
+  }
+
+  filter_reject(pfilter);
+  return filter_average(pfilter, filter_median(pfilter, pfilter->last_accepted), praw_angle);
+}
+
+bool nagi_mt6835_filter_push_frame(
+  nagi_mt6835_filter_t *pfilter,
+  const uint8_t *rx_data,
+  bool check_crc,
+  uint32_t *praw_angle
+) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_warning_t warning = NAGI_MT6835_WARN_NONE;
+
+  const nagi_mt6835_error_t err = nagi_mt6835_continuous_read_decode(rx_data, check_crc, &raw_angle, &warning);
+  if (err != NAGI_MT6835_OK || (pfilter->reject_warnings && warning != NAGI_MT6835_WARN_NONE)) {
+    return nagi_mt6835_filter_push_invalid(pfilter, praw_angle);
+  }
+
+  return nagi_mt6835_filter_push(pfilter, raw_angle, praw_angle);
+}
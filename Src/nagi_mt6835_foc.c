@@ -0,0 +1,99 @@
+#include "nagi_mt6835_foc.h"
+
+/// round(32767 * sin(2 * pi * i / 512)), i = 0 - 512.
+const int16_t nagi_mt6835_foc_sin_table[NAGI_MT6835_FOC_TABLE_SIZE + 1] = {
+       0,    402,    804,   1206,   1608,   2009,   2410,   2811,   3212,   3612,   4011,   4410,
+    4808,   5205,   5602,   5998,   6393,   6786,   7179,   7571,   7962,   8351,   8739,   9126,
+    9512,   9896,  10278,  10659,  11039,  11417,  11793,  12167,  12539,  12910,  13279,  13645,
+   14010,  14372,  14732,  15090,  15446,  15800,  16151,  16499,  16846,  17189,  17530,  17869,
+   18204,  18537,  18868,  19195,  19519,  19841,  20159,  20475,  20787,  21096,  21403,  21705,
+   22005,  22301,  22594,  22884,  23170,  23452,  23731,  24007,  24279,  24547,  24811,  25072,
+   25329,  25582,  25832,  26077,  26319,  26556,  26790,  27019,  27245,  27466,  27683,  27896,
+   28105,  28310,  28510,  28706,  28898,  29085,  29268,  29447,  29621,  29791,  29956,  30117,
+   30273,  30424,  30571,  30714,  30852,  30985,  31113,  31237,  31356,  31470,  31580,  31685,
+   31785,  31880,  31971,  32057,  32137,  32213,  32285,  32351,  32412,  32469,  32521,  32567,
+   32609,  32646,  32678,  32705,  32728,  32745,  32757,  32765,  32767,  32765,  32757,  32745,
+   32728,  32705,  32678,  32646,  32609,  32567,  32521,  32469,  32412,  32351,  32285,  32213,
+   32137,  32057,  31971,  31880,  31785,  31685,  31580,  31470,  31356,  31237,  31113,  30985,
+   30852,  30714,  30571,  30424,  30273,  30117,  29956,  29791,  29621,  29447,  29268,  29085,
+   28898,  28706,  28510,  28310,  28105,  27896,  27683,  27466,  27245,  27019,  26790,  26556,
+   26319,  26077,  25832,  25582,  25329,  25072,  24811,  24547,  24279,  24007,  23731,  23452,
+   23170,  22884,  22594,  22301,  22005,  21705,  21403,  21096,  20787,  20475,  20159,  19841,
+   19519,  19195,  18868,  18537,  18204,  17869,  17530,  17189,  16846,  16499,  16151,  15800,
+   15446,  15090,  14732,  14372,  14010,  13645,  13279,  12910,  12539,  12167,  11793,  11417,
+   11039,  10659,  10278,   9896,   9512,   9126,   8739,   8351,   7962,   7571,   7179,   6786,
+    6393,   5998,   5602,   5205,   4808,   4410,   4011,   3612,   3212,   2811,   2410,   2009,
+    1608,   1206,    804,    402,      0,   -402,   -804,  -1206,  -1608,  -2009,  -2410,  -2811,
+   -3212,  -3612,  -4011,  -4410,  -4808,  -5205,  -5602,  -5998,  -6393,  -6786,  -7179,  -7571,
+   -7962,  -8351,  -8739,  -9126,  -9512,  -9896, -10278, -10659, -11039, -11417, -11793, -12167,
+  -12539, -12910, -13279, -13645, -14010, -14372, -14732, -15090, -15446, -15800, -16151, -16499,
+  -16846, -17189, -17530, -17869, -18204, -18537, -18868, -19195, -19519, -19841, -20159, -20475,
+  -20787, -21096, -21403, -21705, -22005, -22301, -22594, -22884, -23170, -23452, -23731, -24007,
+  -24279, -24547, -24811, -25072, -25329, -25582, -25832, -26077, -26319, -26556, -26790, -27019,
+  -27245, -27466, -27683, -27896, -28105, -28310, -28510, -28706, -28898, -29085, -29268, -29447,
+  -29621, -29791, -29956, -30117, -30273, -30424, -30571, -30714, -30852, -30985, -31113, -31237,
+  -31356, -31470, -31580, -31685, -31785, -31880, -31971, -32057, -32137, -32213, -32285, -32351,
+  -32412, -32469, -32521, -32567, -32609, -32646, -32678, -32705, -32728, -32745, -32757, -32765,
+  -32767, -32765, -32757, -32745, -32728, -32705, -32678, -32646, -32609, -32567, -32521, -32469,
+  -32412, -32351, -32285, -32213, -32137, -32057, -31971, -31880, -31785, -31685, -31580, -31470,
+  -31356, -31237, -31113, -30985, -30852, -30714, -30571, -30424, -30273, -30117, -29956, -29791,
+  -29621, -29447, -29268, -29085, -28898, -28706, -28510, -28310, -28105, -27896, -27683, -27466,
+  -27245, -27019, -26790, -26556, -26319, -26077, -25832, -25582, -25329, -25072, -24811, -24547,
+  -24279, -24007, -23731, -23452, -23170, -22884, -22594, -22301, -22005, -21705, -21403, -21096,
+  -20787, -20475, -20159, -19841, -19519, -19195, -18868, -18537, -18204, -17869, -17530, -17189,
+  -16846, -16499, -16151, -15800, -15446, -15090, -14732, -14372, -14010, -13645, -13279, -12910,
+  -12539, -12167, -11793, -11417, -11039, -10659, -10278,  -9896,  -9512,  -9126,  -8739,  -8351,
+   -7962,  -7571,  -7179,  -6786,  -6393,  -5998,  -5602,  -5205,  -4808,  -4410,  -4011,  -3612,
+   -3212,  -2811,  -2410,  -2009,  -1608,  -1206,   -804,   -402,      0
+};
+
+nagi_mt6835_error_t nagi_mt6835_foc_init(nagi_mt6835_foc_t *pfoc, uint32_t pole_pairs, uint32_t offset) {
+  if (pfoc == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (pole_pairs == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  pfoc->pole_pairs = pole_pairs;
+  pfoc->offset = offset;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_foc_align(nagi_mt6835_foc_t *pfoc, uint32_t raw_angle) {
+  if (pfoc == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (raw_angle >= NAGI_MT6835_ANGLE_RESOLUTION) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  // Cancel the electrical angle of raw_angle without the old offset.
+  pfoc->offset = 0u - (raw_angle << 11) * pfoc->pole_pairs;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_foc_read_q15(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  const nagi_mt6835_foc_t *pfoc,
+  nagi_mt6835_foc_q15_t *pout
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pfoc == NULL || pout == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  nagi_mt6835_foc_update_q15(pfoc, raw_angle, pout);
+  return NAGI_MT6835_OK;
+}
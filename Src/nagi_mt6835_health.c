@@ -0,0 +1,182 @@
+#include "nagi_mt6835_health.h"
+
+#include <math.h>
+#include <string.h>
+
+/// @brief Add a value to a Welford accumulator.
+/// @param pstat accumulator.
+/// @param value value.
+static inline void health_stat_add(nagi_mt6835_health_stat_t *pstat, float value) {
+  pstat->count++;
+  const float delta = value - pstat->mean;
+  pstat->mean += delta / (float)pstat->count;
+  pstat->m2 += delta * (value - pstat->mean);
+}
+
+/// @brief Merge a Welford accumulator into another, Chan et al.
+/// @param pstat accumulator.
+/// @param pother accumulator to merge.
+static void health_stat_merge(nagi_mt6835_health_stat_t *pstat, const nagi_mt6835_health_stat_t *pother) {
+  if (pother->count == 0) {
+    return;
+  }
+  if (pstat->count == 0) {
+    *pstat = *pother;
+    return;
+  }
+
+  const float count = (float)pstat->count + (float)pother->count;
+  const float delta = pother->mean - pstat->mean;
+  pstat->mean += delta * (float)pother->count / count;
+  pstat->m2 += pother->m2 + delta * delta * (float)pstat->count * (float)pother->count / count;
+  pstat->count += pother->count;
+}
+
+/// @brief Merge a block into another.
+/// @param pblock block.
+/// @param pother block to merge.
+static void health_block_merge(nagi_mt6835_health_block_t *pblock, const nagi_mt6835_health_block_t *pother) {
+  pblock->samples += pother->samples;
+  pblock->crc_errors += pother->crc_errors;
+  pblock->bus_errors += pother->bus_errors;
+  pblock->warnings += pother->warnings;
+  pblock->over_speed += pother->over_speed;
+  pblock->field_weak += pother->field_weak;
+  pblock->under_voltage += pother->under_voltage;
+  health_stat_merge(&pblock->delta, &pother->delta);
+  health_stat_merge(&pblock->residual, &pother->residual);
+}
+
+/// @brief Sample variance of an accumulator.
+/// @param pstat accumulator.
+/// @return variance, 0 below two values.
+static float health_stat_variance(const nagi_mt6835_health_stat_t *pstat) {
+  return pstat->count > 1 ? pstat->m2 / (float)(pstat->count - 1) : 0.0f;
+}
+
+nagi_mt6835_error_t nagi_mt6835_health_init(
+  nagi_mt6835_health_t *phealth,
+  nagi_mt6835_health_block_t *blocks,
+  uint32_t block_count,
+  uint32_t block_samples
+) {
+  if (phealth == NULL || blocks == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (block_count == 0 || block_samples == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  phealth->blocks = blocks;
+  phealth->block_count = block_count;
+  phealth->block_samples = block_samples;
+
+  return nagi_mt6835_health_reset(phealth);
+}
+
+nagi_mt6835_error_t nagi_mt6835_health_reset(nagi_mt6835_health_t *phealth) {
+  if (phealth == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  phealth->block_index = 0;
+  phealth->block_fill = 0;
+  memset(&phealth->current, 0, sizeof(phealth->current));
+  phealth->history = 0;
+  phealth->last_raw_angle = 0;
+  phealth->last_delta = 0;
+  phealth->next_seq = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_health_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_health_t *phealth) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  if (phealth == NULL) {
+    return nagi_mt6835_remove_sample_hook(pmt6835, nagi_mt6835_health_push, NULL);
+  }
+  return nagi_mt6835_add_sample_hook(pmt6835, nagi_mt6835_health_push, phealth);
+}
+
+void nagi_mt6835_health_push(void *ctx, const nagi_mt6835_sample_t *psample) {
+  nagi_mt6835_health_t *phealth = (nagi_mt6835_health_t *)ctx;
+  nagi_mt6835_health_block_t *pcurrent = &phealth->current;
+
+  // A failed transfer leaves crc_ok false without a CRC check, count it apart.
+  const bool bus_error = (psample->angle_flags & NAGI_MT6835_ANGLE_FLAG_BUS_ERROR) != 0;
+  const bool retried = (psample->angle_flags & NAGI_MT6835_ANGLE_FLAG_RETRIED) != 0;
+  pcurrent->samples++;
+  pcurrent->crc_errors += (!psample->crc_ok && !bus_error) || retried;
+  pcurrent->bus_errors += bus_error;
+  pcurrent->warnings += psample->warning != NAGI_MT6835_WARN_NONE;
+  pcurrent->over_speed += (psample->warning & NAGI_MT6835_WARN_OVER_SPEED) != 0;
+  pcurrent->field_weak += (psample->warning & NAGI_MT6835_WARN_FIELD_WEAK) != 0;
+  pcurrent->under_voltage += (psample->warning & NAGI_MT6835_WARN_UNDER_VOLTAGE) != 0;
+
+  // Only consecutive measured samples make moves.
+  const uint8_t not_measured =
+    NAGI_MT6835_ANGLE_FLAG_LAST_GOOD | NAGI_MT6835_ANGLE_FLAG_PREDICTED | NAGI_MT6835_ANGLE_FLAG_BUS_ERROR;
+  const bool measured = psample->crc_ok && (psample->angle_flags & not_measured) == 0;
+  if (!measured || psample->seq != phealth->next_seq) {
+    phealth->history = 0;
+  }
+  phealth->next_seq = psample->seq + 1;
+
+  if (measured) {
+    if (phealth->history > 0) {
+      // Sign extend the 21-bit difference.
+      const int32_t delta = (int32_t)((psample->raw_angle - phealth->last_raw_angle) << 11) >> 11;
+      health_stat_add(&pcurrent->delta, (float)delta);
+      if (phealth->history > 1) {
+        health_stat_add(&pcurrent->residual, (float)(delta - phealth->last_delta));
+      }
+      phealth->last_delta = delta;
+    }
+    phealth->last_raw_angle = psample->raw_angle;
+    phealth->history += phealth->history < 2;
+  }
+
+  if (pcurrent->samples >= phealth->block_samples) {
+    phealth->blocks[phealth->block_index] = *pcurrent;
+    phealth->block_index = phealth->block_index + 1 == phealth->block_count ? 0 : phealth->block_index + 1;
+    phealth->block_fill += phealth->block_fill < phealth->block_count;
+    memset(pcurrent, 0, sizeof(*pcurrent));
+  }
+}
+
+nagi_mt6835_error_t nagi_mt6835_health_get(
+  const nagi_mt6835_health_t *phealth,
+  nagi_mt6835_health_metrics_t *pmetrics
+) {
+  if (phealth == NULL || pmetrics == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  nagi_mt6835_health_block_t total = phealth->current;
+  for (uint32_t i = 0; i < phealth->block_fill; i++) {
+    health_block_merge(&total, &phealth->blocks[i]);
+  }
+
+  memset(pmetrics, 0, sizeof(*pmetrics));
+  pmetrics->samples = total.samples;
+  if (total.samples == 0) {
+    return NAGI_MT6835_OK;
+  }
+
+  const float samples = (float)total.samples;
+  pmetrics->speed = total.delta.mean;
+  pmetrics->jitter = sqrtf(health_stat_variance(&total.delta));
+  pmetrics->residual_variance = health_stat_variance(&total.residual);
+  pmetrics->noise = sqrtf(pmetrics->residual_variance / 6.0f);
+  pmetrics->crc_error_rate = (float)total.crc_errors / samples;
+  pmetrics->bus_error_rate = (float)total.bus_errors / samples;
+  pmetrics->warning_rate = (float)total.warnings / samples;
+  pmetrics->over_speed_rate = (float)total.over_speed / samples;
+  pmetrics->field_weak_rate = (float)total.field_weak / samples;
+  pmetrics->under_voltage_rate = (float)total.under_voltage / samples;
+
+  return NAGI_MT6835_OK;
+}
@@ -0,0 +1,81 @@
+#include "nagi_mt6835_multiturn.h"
+
+/// @brief Clamp max delta to half a turn.
+/// @param max_delta max delta, 0 for half a turn.
+/// @return max delta.
+static uint32_t multiturn_max_delta(uint32_t max_delta) {
+  if (max_delta == 0 || max_delta > NAGI_MT6835_MULTITURN_HALF_TURN) {
+    return NAGI_MT6835_MULTITURN_HALF_TURN;
+  }
+
+  return max_delta;
+}
+
+nagi_mt6835_error_t nagi_mt6835_multiturn_init(
+  nagi_mt6835_multiturn_t *ptracker,
+  uint32_t raw_angle,
+  uint32_t max_delta
+) {
+  if (ptracker == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (raw_angle >= NAGI_MT6835_ANGLE_RESOLUTION) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  ptracker->position = raw_angle;
+  ptracker->last_raw_angle = raw_angle;
+  ptracker->max_delta = multiturn_max_delta(max_delta);
+  ptracker->alias_count = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_multiturn_restore(
+  nagi_mt6835_multiturn_t *ptracker,
+  int64_t saved_position,
+  uint32_t raw_angle,
+  uint32_t max_delta
+) {
+  if (ptracker == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (raw_angle >= NAGI_MT6835_ANGLE_RESOLUTION) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  const uint32_t saved_raw_angle = (uint32_t)saved_position & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  ptracker->position = saved_position + nagi_mt6835_multiturn_delta(raw_angle, saved_raw_angle);
+  ptracker->last_raw_angle = raw_angle;
+  ptracker->max_delta = multiturn_max_delta(max_delta);
+  ptracker->alias_count = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_multiturn_read(
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_read_angle_method_enum_t method,
+  nagi_mt6835_multiturn_t *ptracker,
+  bool *paliased
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (ptracker == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t raw_angle = 0;
+  nagi_mt6835_error_t err = nagi_mt6835_get_raw_angle(pmt6835, method, &raw_angle);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  const bool aliased = nagi_mt6835_multiturn_update(ptracker, raw_angle);
+  if (paliased != NULL) {
+    *paliased = aliased;
+  }
+
+  return NAGI_MT6835_OK;
+}
@@ -0,0 +1,229 @@
+#include "nagi_mt6835_observer.h"
+
+#define OBSERVER_TWO_PI      (6.283185307f)
+#define OBSERVER_Q32_PER_RAD (683565275.5764316f)
+#define OBSERVER_RAD_PER_Q32 (1.4629180792671596e-9f)
+#define OBSERVER_Q32_ONE     (4294967296.0f)
+
+/// @brief Validate an observer configuration.
+/// @param pconfig configuration.
+/// @param pw loop bandwidth in rad/s.
+/// @return mt6835 error code.
+static nagi_mt6835_error_t observer_check_config(const nagi_mt6835_observer_config_t *pconfig, float *pw) {
+  if (pconfig->timer_hz == 0 || pconfig->sample_hz == 0 || pconfig->sample_hz > pconfig->timer_hz) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  const float w = pconfig->bandwidth_hz * OBSERVER_TWO_PI;
+  // k1 = 3 w dt must stay below 1 at the nominal rate, also keeps the Q32 gains in range.
+  if (!(w > 0.0f) || 3.0f * w >= (float)pconfig->sample_hz) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  *pw = w;
+  return NAGI_MT6835_OK;
+}
+
+/// @brief Convert an angle difference in rad to Q32 turns.
+/// @param rad angle difference in rad.
+/// @return angle difference, Q32 turns, wrapped.
+static uint32_t observer_rad_to_q32(float rad) {
+  return (uint32_t)(int64_t)(rad * OBSERVER_Q32_PER_RAD);
+}
+
+/// @brief Extrapolate the float observer angle.
+/// @param pobserver observer.
+/// @param target_time time in ticks.
+/// @return angle, Q32 turns.
+static uint32_t observer_f32_extrapolate(const nagi_mt6835_observer_f32_t *pobserver, uint32_t target_time) {
+  const float dt = (float)(int32_t)(target_time - pobserver->timestamp) * pobserver->tick_s;
+  const float delta = (pobserver->velocity + 0.5f * pobserver->acceleration * dt) * dt;
+  return pobserver->angle + observer_rad_to_q32(delta);
+}
+
+/// @brief Extrapolate the fixed point observer angle.
+/// @param pobserver observer.
+/// @param target_time time in ticks.
+/// @return angle, Q32 turns.
+static uint32_t observer_q32_extrapolate(const nagi_mt6835_observer_q32_t *pobserver, uint32_t target_time) {
+  // Samples ahead, Q16.
+  const int64_t ticks = (int32_t)(target_time - pobserver->timestamp);
+  const int64_t samples = (ticks * (int64_t)pobserver->samples_per_tick) >> 16;
+
+  // Q32 rates times Q16 samples.
+  const int64_t velocity = pobserver->velocity >> 16;
+  const int64_t acceleration = pobserver->acceleration >> 16;
+  const int64_t half_acc_dt = ((acceleration * samples) >> 16) / 2;
+  return pobserver->angle + (uint32_t)(((velocity + half_acc_dt) * samples) >> 16);
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_f32_init(
+  nagi_mt6835_observer_f32_t *pobserver,
+  const nagi_mt6835_observer_config_t *pconfig,
+  uint32_t raw_angle,
+  uint32_t timestamp
+) {
+  if (pobserver == NULL || pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  float w = 0.0f;
+  nagi_mt6835_error_t err = observer_check_config(pconfig, &w);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  pobserver->angle = raw_angle << 11;
+  pobserver->velocity = 0.0f;
+  pobserver->acceleration = 0.0f;
+  pobserver->timestamp = timestamp;
+  pobserver->tick_s = 1.0f / (float)pconfig->timer_hz;
+  pobserver->max_gain_dt = 1.0f / (3.0f * w);
+  pobserver->k1 = 3.0f * w;
+  pobserver->k2 = 3.0f * w * w;
+  pobserver->k3 = w * w * w;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_f32_update(
+  nagi_mt6835_observer_f32_t *pobserver,
+  uint32_t raw_angle,
+  uint32_t timestamp
+) {
+  if (pobserver == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  const float dt = (float)(timestamp - pobserver->timestamp) * pobserver->tick_s;
+  const float gain_dt = dt < pobserver->max_gain_dt ? dt : pobserver->max_gain_dt;
+
+  // Predict.
+  const float half_acc_dt = 0.5f * pobserver->acceleration * dt;
+  const uint32_t angle = pobserver->angle + observer_rad_to_q32((pobserver->velocity + half_acc_dt) * dt);
+  const float velocity = pobserver->velocity + pobserver->acceleration * dt;
+
+  // Correct.
+  const float e = (float)(int32_t)((raw_angle << 11) - angle) * OBSERVER_RAD_PER_Q32;
+  pobserver->angle = angle + observer_rad_to_q32(pobserver->k1 * gain_dt * e);
+  pobserver->velocity = velocity + pobserver->k2 * gain_dt * e;
+  pobserver->acceleration += pobserver->k3 * gain_dt * e;
+  pobserver->timestamp = timestamp;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_f32_extrapolate(
+  const nagi_mt6835_observer_f32_t *pobserver,
+  uint32_t target_time,
+  float *pangle
+) {
+  if (pobserver == NULL || pangle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  *pangle = (float)observer_f32_extrapolate(pobserver, target_time) * OBSERVER_RAD_PER_Q32;
+
+  return NAGI_MT6835_OK;
+}
+
+float nagi_mt6835_observer_f32_get_angle(const nagi_mt6835_observer_f32_t *pobserver) {
+  if (pobserver == NULL) {
+    return 0.0f;
+  }
+
+  return (float)pobserver->angle * OBSERVER_RAD_PER_Q32;
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_q32_init(
+  nagi_mt6835_observer_q32_t *pobserver,
+  const nagi_mt6835_observer_config_t *pconfig,
+  uint32_t raw_angle,
+  uint32_t timestamp
+) {
+  if (pobserver == NULL || pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  float w = 0.0f;
+  nagi_mt6835_error_t err = observer_check_config(pconfig, &w);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  // Gains per sample, w dt < 1 / 3.
+  const float wdt = w / (float)pconfig->sample_hz;
+
+  pobserver->angle = raw_angle << 11;
+  pobserver->velocity = 0;
+  pobserver->acceleration = 0;
+  pobserver->timestamp = timestamp;
+  pobserver->samples_per_tick = ((uint64_t)pconfig->sample_hz << 32) / pconfig->timer_hz;
+  pobserver->sample_hz = pconfig->sample_hz;
+  pobserver->k1 = (uint32_t)(3.0f * wdt * OBSERVER_Q32_ONE);
+  pobserver->k2 = (uint32_t)(3.0f * wdt * wdt * OBSERVER_Q32_ONE);
+  pobserver->k3 = (uint32_t)(wdt * wdt * wdt * OBSERVER_Q32_ONE);
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_q32_update(
+  nagi_mt6835_observer_q32_t *pobserver,
+  uint32_t raw_angle,
+  uint32_t timestamp
+) {
+  if (pobserver == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  // Predict, Q48 rates, one sample.
+  const uint32_t angle = pobserver->angle + (uint32_t)((pobserver->velocity + pobserver->acceleration / 2) >> 16);
+  const int64_t velocity = pobserver->velocity + pobserver->acceleration;
+
+  // Correct, Q32 gain * Q32 error fits int64_t as both gains are below 1.
+  const int64_t e = (int32_t)((raw_angle << 11) - angle);
+  pobserver->angle = angle + (uint32_t)((pobserver->k1 * e) >> 32);
+  pobserver->velocity = velocity + ((pobserver->k2 * e) >> 16);
+  pobserver->acceleration += (pobserver->k3 * e) >> 16;
+  pobserver->timestamp = timestamp;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_observer_q32_extrapolate(
+  const nagi_mt6835_observer_q32_t *pobserver,
+  uint32_t target_time,
+  uint32_t *pangle
+) {
+  if (pobserver == NULL || pangle == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  *pangle = observer_q32_extrapolate(pobserver, target_time);
+
+  return NAGI_MT6835_OK;
+}
+
+int64_t nagi_mt6835_observer_q32_get_velocity(const nagi_mt6835_observer_q32_t *pobserver) {
+  if (pobserver == NULL) {
+    return 0;
+  }
+
+  return ((pobserver->velocity >> 16) * pobserver->sample_hz) >> 16;
+}
+
+int64_t nagi_mt6835_observer_q32_get_acceleration(const nagi_mt6835_observer_q32_t *pobserver) {
+  if (pobserver == NULL) {
+    return 0;
+  }
+
+  return (((pobserver->acceleration >> 16) * pobserver->sample_hz) >> 16) * pobserver->sample_hz;
+}
+
+uint32_t nagi_mt6835_observer_f32_predict(void *ctx, uint32_t timestamp) {
+  return observer_f32_extrapolate((const nagi_mt6835_observer_f32_t *)ctx, timestamp) >> 11;
+}
+
+uint32_t nagi_mt6835_observer_q32_predict(void *ctx, uint32_t timestamp) {
+  return observer_q32_extrapolate((const nagi_mt6835_observer_q32_t *)ctx, timestamp) >> 11;
+}
@@ -0,0 +1,174 @@
+#include "nagi_mt6835_profile.h"
+
+#include <string.h>
+
+#define PROFILE_REG(regs, reg) ((regs)[(reg) - NAGI_MT6835_SHADOW_REG_FIRST])
+
+/// @brief Replace bits of a register value.
+/// @param reg register value.
+/// @param mask bits to replace.
+/// @param value new bits, already shifted.
+/// @return register value.
+static uint8_t profile_set_bits(uint8_t reg, uint8_t mask, uint8_t value) {
+  return (uint8_t)((reg & ~mask) | (value & mask));
+}
+
+nagi_mt6835_error_t nagi_mt6835_profile_validate(const nagi_mt6835_profile_t *pprofile) {
+  if (pprofile == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if ((pprofile->fields & ~NAGI_MT6835_PROFILE_FIELD_ALL) != 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pprofile->abz_resolution > 0x3FFF || pprofile->zero_position > 0xFFF) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pprofile->abz_z_pulse_width > 7 || pprofile->abz_z_phase > 3 || pprofile->uvw > 0x3F) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_profile_build(
+  const nagi_mt6835_profile_t *pprofile,
+  const uint8_t *cur_regs,
+  uint8_t *target_regs,
+  uint16_t *pdiff_mask
+) {
+  if (pprofile == NULL || cur_regs == NULL || target_regs == NULL || pdiff_mask == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  nagi_mt6835_error_t err = nagi_mt6835_profile_validate(pprofile);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  const uint32_t fields = pprofile->fields;
+  uint8_t regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  memcpy(regs, cur_regs, sizeof(regs));
+
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ID) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ID) = pprofile->id;
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_RESOLUTION) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES2) = (pprofile->abz_resolution >> 6) & 0xFF;
+    PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1), 0b11111100, (pprofile->abz_resolution & 0b00111111) << 2
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_OUTPUT) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1), 0b00000010, pprofile->abz_output_enable ? 0 : 0b00000010
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_AB_SWAP) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ABZ_RES1), 0b00000001, pprofile->abz_ab_swap ? 0b00000001 : 0
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ZERO_POSITION) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ZERO2) = pprofile->zero_position >> 4;
+    PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1), 0b11110000, (pprofile->zero_position & 0b00001111) << 4
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_Z_EDGE) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1), 0b00001000, pprofile->abz_z_edge_up ? 0b00001000 : 0
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_Z_PULSE_WIDTH) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_ZERO1), 0b00000111, pprofile->abz_z_pulse_width
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_ABZ_Z_PHASE) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_UVW) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_UVW), 0b11000000, pprofile->abz_z_phase << 6
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_UVW) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_UVW) = profile_set_bits(
+      PROFILE_REG(regs, NAGI_MT6835_REG_UVW), 0b00111111, pprofile->uvw
+    );
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_PWM) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_PWM) = pprofile->pwm;
+  }
+  if (fields & NAGI_MT6835_PROFILE_FIELD_HYST) {
+    PROFILE_REG(regs, NAGI_MT6835_REG_HYST) = pprofile->hyst;
+  }
+
+  uint16_t diff_mask = 0;
+  for (int reg = NAGI_MT6835_SHADOW_REG_FIRST; reg <= NAGI_MT6835_SHADOW_REG_LAST; reg++) {
+    if (PROFILE_REG(regs, reg) != PROFILE_REG(cur_regs, reg)) {
+      diff_mask |= 1u << reg;
+    }
+  }
+
+  memcpy(target_regs, regs, sizeof(regs));
+  *pdiff_mask = diff_mask;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_profile_apply(
+  nagi_mt6835_t *pmt6835,
+  const nagi_mt6835_profile_t *pprofile,
+  bool program_eeprom,
+  nagi_mt6835_profile_result_t *presult
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pprofile == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  nagi_mt6835_profile_result_t result = {0};
+  if (presult != NULL) {
+    *presult = result;
+  }
+
+  nagi_mt6835_error_t err = nagi_mt6835_profile_validate(pprofile);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  // One burst read of the whole configuration into a local, the shadow cache stays opt-in.
+  uint8_t cur_regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  err = nagi_mt6835_read_regs(pmt6835, NAGI_MT6835_SHADOW_REG_FIRST, cur_regs, NAGI_MT6835_SHADOW_REG_COUNT);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  uint8_t target_regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  uint16_t diff_mask = 0;
+  err = nagi_mt6835_profile_build(pprofile, cur_regs, target_regs, &diff_mask);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  // Ascending order keeps the high byte of ABZ_RES and ZERO written before the low byte.
+  for (int reg = NAGI_MT6835_SHADOW_REG_FIRST; reg <= NAGI_MT6835_SHADOW_REG_LAST; reg++) {
+    if ((diff_mask & (1u << reg)) == 0) {
+      continue;
+    }
+    err = nagi_mt6835_write_reg(pmt6835, (nagi_mt6835_reg_enum_t)reg, PROFILE_REG(target_regs, reg));
+    if (err != NAGI_MT6835_OK) {
+      break;
+    }
+    result.written_mask |= 1u << reg;
+    result.write_count++;
+  }
+
+  if (err == NAGI_MT6835_OK && program_eeprom && result.write_count > 0) {
+    err = nagi_mt6835_program_eeprom(pmt6835);
+    result.eeprom_programmed = err == NAGI_MT6835_OK;
+  }
+
+  if (presult != NULL) {
+    *presult = result;
+  }
+  return err;
+}
@@ -0,0 +1,97 @@
+#include "nagi_mt6835_pub.h"
+
+// Packed angle word, raw angle 0 - 20, warning 21 - 23, CRC ok 24, angle flags 25 - 29, valid 31.
+#define PUB_WARNING_SHIFT     (21)
+#define PUB_CRC_OK_SHIFT      (24)
+#define PUB_ANGLE_FLAGS_SHIFT (25)
+#define PUB_VALID             (0x80000000u)
+
+_Static_assert(sizeof(_Atomic uint32_t) == sizeof(uint32_t), "C++ sees the atomic words as uint32_t");
+
+/// @brief Write one sample copy.
+/// @param copy sample copy.
+/// @param psample sample.
+static void pub_store_copy(_Atomic uint32_t *copy, const nagi_mt6835_sample_t *psample) {
+  const uint32_t word = (psample->raw_angle & (NAGI_MT6835_ANGLE_RESOLUTION - 1)) |
+                        ((uint32_t)(psample->warning & 0x07) << PUB_WARNING_SHIFT) |
+                        ((uint32_t)psample->crc_ok << PUB_CRC_OK_SHIFT) |
+                        ((uint32_t)(psample->angle_flags & 0x1F) << PUB_ANGLE_FLAGS_SHIFT) |
+                        PUB_VALID;
+
+  atomic_store_explicit(&copy[0], word, memory_order_relaxed);
+  atomic_store_explicit(&copy[1], psample->timestamp, memory_order_relaxed);
+  atomic_store_explicit(&copy[2], psample->seq, memory_order_relaxed);
+}
+
+nagi_mt6835_error_t nagi_mt6835_pub_init(nagi_mt6835_pub_t *ppub) {
+  if (ppub == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  atomic_init(&ppub->latch, 0);
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t k = 0; k < NAGI_MT6835_PUB_WORDS; k++) {
+      atomic_init(&ppub->copies[i][k], 0);
+    }
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_pub_attach(nagi_mt6835_t *pmt6835, nagi_mt6835_pub_t *ppub) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  if (ppub == NULL) {
+    return nagi_mt6835_remove_sample_hook(pmt6835, nagi_mt6835_pub_publish, NULL);
+  }
+  return nagi_mt6835_add_sample_hook(pmt6835, nagi_mt6835_pub_publish, ppub);
+}
+
+void nagi_mt6835_pub_publish(void *ctx, const nagi_mt6835_sample_t *psample) {
+  nagi_mt6835_pub_t *ppub = (nagi_mt6835_pub_t *)ctx;
+  const uint32_t latch = atomic_load_explicit(&ppub->latch, memory_order_relaxed);
+
+  // Readers move to copy 1, the fence keeps the copy 0 stores behind the counter.
+  atomic_store_explicit(&ppub->latch, latch + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  pub_store_copy(ppub->copies[0], psample);
+
+  // Copy 0 is complete before readers move back to it.
+  atomic_store_explicit(&ppub->latch, latch + 2, memory_order_release);
+  atomic_thread_fence(memory_order_release);
+  pub_store_copy(ppub->copies[1], psample);
+}
+
+nagi_mt6835_error_t nagi_mt6835_pub_read(nagi_mt6835_pub_t *ppub, nagi_mt6835_sample_t *psample) {
+  if (ppub == NULL || psample == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  uint32_t latch = 0;
+  uint32_t word = 0;
+  uint32_t timestamp = 0;
+  uint32_t seq = 0;
+  do {
+    latch = atomic_load_explicit(&ppub->latch, memory_order_acquire);
+    const _Atomic uint32_t *copy = ppub->copies[latch & 1];
+    word = atomic_load_explicit(&copy[0], memory_order_relaxed);
+    timestamp = atomic_load_explicit(&copy[1], memory_order_relaxed);
+    seq = atomic_load_explicit(&copy[2], memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+  } while (atomic_load_explicit(&ppub->latch, memory_order_relaxed) != latch);
+
+  if ((word & PUB_VALID) == 0) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  psample->raw_angle = word & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  psample->timestamp = timestamp;
+  psample->seq = seq;
+  psample->warning = (nagi_mt6835_warning_t)((word >> PUB_WARNING_SHIFT) & 0x07);
+  psample->crc_ok = (word >> PUB_CRC_OK_SHIFT) & 0x01;
+  psample->angle_flags = (uint8_t)((word >> PUB_ANGLE_FLAGS_SHIFT) & 0x1F);
+
+  return NAGI_MT6835_OK;
+}
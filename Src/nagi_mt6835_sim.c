@@ -0,0 +1,315 @@
+#include "nagi_mt6835_sim.h"
+
+#include <string.h>
+
+#define SIM_ANGLE_MASK (NAGI_MT6835_ANGLE_RESOLUTION - 1)
+#define SIM_ACK (0x55)
+
+static nagi_mt6835_sim_t *bound_sim = NULL;
+
+/// @brief Bitwise CRC8 (poly 0x07), independent of the driver table.
+/// @param data The data to be checked.
+/// @param len The length of the data.
+/// @return CRC value.
+static uint8_t sim_crc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0x00;
+
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+/// @brief Get mechanical angle of a sample from the trajectory.
+/// @param psim simulator handle.
+/// @param tick sample index.
+/// @return mechanical raw angle.
+static uint32_t sim_trajectory_angle(const nagi_mt6835_sim_t *psim, uint32_t tick) {
+  const nagi_mt6835_sim_trajectory_t *ptraj = &psim->trajectory;
+
+  switch (ptraj->type) {
+    case NAGI_MT6835_SIM_TRAJECTORY_VELOCITY:
+      return (ptraj->start_angle + (uint32_t)ptraj->velocity * tick) & SIM_ANGLE_MASK;
+    case NAGI_MT6835_SIM_TRAJECTORY_CUSTOM:
+      if (ptraj->angle_fn != NULL) {
+        return ptraj->angle_fn(ptraj->angle_fn_ctx, tick) & SIM_ANGLE_MASK;
+      }
+      break;
+    case NAGI_MT6835_SIM_TRAJECTORY_CONSTANT:
+    default:
+      break;
+  }
+
+  return ptraj->start_angle & SIM_ANGLE_MASK;
+}
+
+/// @brief Get zero position from the register file.
+/// @param psim simulator handle.
+/// @return zero position (12 bits).
+static uint16_t sim_zero_position(const nagi_mt6835_sim_t *psim) {
+  return (uint16_t)((psim->regs[NAGI_MT6835_REG_ZERO2] << 4) | (psim->regs[NAGI_MT6835_REG_ZERO1] >> 4));
+}
+
+/// @brief Latch a new angle sample into the angle and CRC registers.
+/// @param psim simulator handle.
+static void sim_latch_angle(nagi_mt6835_sim_t *psim) {
+  psim->mech_angle = sim_trajectory_angle(psim, psim->tick);
+  psim->tick++;
+  psim->stats.samples++;
+
+  uint32_t angle = (psim->mech_angle - ((uint32_t)sim_zero_position(psim) << 9)) & SIM_ANGLE_MASK;
+
+  psim->regs[NAGI_MT6835_REG_ANGLE3] = (angle >> 13) & 0xFF;
+  psim->regs[NAGI_MT6835_REG_ANGLE2] = (angle >> 5) & 0xFF;
+  psim->regs[NAGI_MT6835_REG_ANGLE1] = ((angle & 0x1F) << 3) | (psim->warning & 0x07);
+
+  uint8_t crc = sim_crc8(&psim->regs[NAGI_MT6835_REG_ANGLE3], 3);
+  if (psim->crc_error_count > 0) {
+    psim->crc_error_count--;
+    crc ^= 0xFF;
+  }
+  psim->regs[NAGI_MT6835_REG_CRC] = crc;
+}
+
+/// @brief Check register is read only.
+/// @param reg register address.
+/// @return true if read only.
+static bool sim_reg_read_only(uint16_t reg) {
+  return reg >= NAGI_MT6835_REG_ANGLE3 && reg <= NAGI_MT6835_REG_CRC;
+}
+
+/// @brief Clock one byte through the simulator.
+/// @param psim simulator handle.
+/// @param tx tx byte.
+/// @return rx byte.
+static uint8_t sim_clock_byte(nagi_mt6835_sim_t *psim, uint8_t tx) {
+  const size_t pos = psim->frame_pos++;
+  uint8_t rx = 0x00;
+
+  if (pos == 0) {
+    psim->frame_cmd = tx >> 4;
+    psim->frame_reg = (uint16_t)(tx & 0x0F) << 8;
+    psim->stats.cmd_count[psim->frame_cmd]++;
+    return rx;
+  }
+  if (pos == 1) {
+    psim->frame_reg |= tx;
+    if ((psim->frame_cmd == NAGI_MT6835_CMD_RD && psim->frame_reg == NAGI_MT6835_REG_ANGLE3) ||
+        (psim->frame_cmd == NAGI_MT6835_CMD_CONTINUE && psim->frame_reg <= NAGI_MT6835_REG_ANGLE3)) {
+      sim_latch_angle(psim);
+    }
+    return rx;
+  }
+
+  const uint16_t reg = psim->frame_reg;
+  switch (psim->frame_cmd) {
+    case NAGI_MT6835_CMD_RD:
+      if (pos == 2 && reg < NAGI_MT6835_SIM_REG_COUNT) {
+        rx = psim->regs[reg];
+      }
+      break;
+    case NAGI_MT6835_CMD_WR:
+      if (pos == 2 && reg < NAGI_MT6835_SIM_REG_COUNT && !sim_reg_read_only(reg)) {
+        psim->regs[reg] = tx;
+      }
+      break;
+    case NAGI_MT6835_CMD_CONTINUE: {
+      const size_t cont_reg = reg + (pos - 2);
+      if (cont_reg < NAGI_MT6835_SIM_REG_COUNT) {
+        rx = psim->regs[cont_reg];
+      }
+      break;
+    }
+    case NAGI_MT6835_CMD_EEPROM:
+      if (pos == 2) {
+        memcpy(psim->eeprom, psim->regs, sizeof(psim->eeprom));
+        psim->stats.eeprom_programs++;
+        rx = SIM_ACK;
+      }
+      break;
+    case NAGI_MT6835_CMD_ZERO:
+      if (pos == 2) {
+        uint16_t zero_pos = (uint16_t)(sim_trajectory_angle(psim, psim->tick) >> 9);
+        psim->regs[NAGI_MT6835_REG_ZERO2] = zero_pos >> 4;
+        psim->regs[NAGI_MT6835_REG_ZERO1] = ((zero_pos & 0x0F) << 4) | (psim->regs[NAGI_MT6835_REG_ZERO1] & 0x0F);
+        rx = SIM_ACK;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return rx;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_init(nagi_mt6835_sim_t *psim) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  memset(psim, 0, sizeof(*psim));
+  psim->trajectory.type = NAGI_MT6835_SIM_TRAJECTORY_CONSTANT;
+  psim->warning = NAGI_MT6835_WARN_NONE;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_set_trajectory(
+  nagi_mt6835_sim_t *psim,
+  const nagi_mt6835_sim_trajectory_t *ptrajectory
+) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (ptrajectory == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (ptrajectory->type == NAGI_MT6835_SIM_TRAJECTORY_CUSTOM && ptrajectory->angle_fn == NULL) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  psim->trajectory = *ptrajectory;
+  psim->tick = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_set_warning(nagi_mt6835_sim_t *psim, nagi_mt6835_warning_t warning) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if ((warning & ~0x07) != 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  psim->warning = warning;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_inject_crc_errors(nagi_mt6835_sim_t *psim, uint32_t count) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  psim->crc_error_count = count;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_power_cycle(nagi_mt6835_sim_t *psim) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  memcpy(psim->regs, psim->eeprom, sizeof(psim->regs));
+  psim->cs = false;
+  psim->frame_pos = 0;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_get_stats(const nagi_mt6835_sim_t *psim, nagi_mt6835_sim_stats_t *pstats) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pstats == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  *pstats = psim->stats;
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_reset_stats(nagi_mt6835_sim_t *psim) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  memset(&psim->stats, 0, sizeof(psim->stats));
+  return NAGI_MT6835_OK;
+}
+
+void nagi_mt6835_sim_bind(nagi_mt6835_sim_t *psim) {
+  bound_sim = psim;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_make_config(nagi_mt6835_config_t *pconfig, bool enable_crc_check) {
+  if (pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  memset(pconfig, 0, sizeof(*pconfig));
+  pconfig->chip_select_fn = nagi_mt6835_sim_chip_select;
+  pconfig->read_write_fn = nagi_mt6835_sim_read_write;
+  pconfig->delay_fn = nagi_mt6835_sim_delay;
+  pconfig->enable_crc_check = enable_crc_check;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_sim_make_ctx_config(
+  nagi_mt6835_sim_t *psim,
+  nagi_mt6835_config_t *pconfig,
+  bool enable_crc_check
+) {
+  if (psim == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  memset(pconfig, 0, sizeof(*pconfig));
+  pconfig->chip_select_ctx_fn = nagi_mt6835_sim_chip_select_ctx;
+  pconfig->read_write_ctx_fn = nagi_mt6835_sim_read_write_ctx;
+  pconfig->delay_fn = nagi_mt6835_sim_delay;
+  pconfig->user_ctx = psim;
+  pconfig->enable_crc_check = enable_crc_check;
+
+  return NAGI_MT6835_OK;
+}
+
+void nagi_mt6835_sim_chip_select(bool select) {
+  nagi_mt6835_sim_chip_select_ctx(bound_sim, select);
+}
+
+int nagi_mt6835_sim_read_write(uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  return nagi_mt6835_sim_read_write_ctx(bound_sim, tx_data, rx_data, size);
+}
+
+void nagi_mt6835_sim_chip_select_ctx(void *ctx, bool select) {
+  nagi_mt6835_sim_t *psim = (nagi_mt6835_sim_t *)ctx;
+  if (psim == NULL) {
+    return;
+  }
+
+  if (select && !psim->cs) {
+    psim->stats.transactions++;
+  }
+  psim->cs = select;
+  psim->frame_pos = 0;
+}
+
+int nagi_mt6835_sim_read_write_ctx(void *ctx, uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  nagi_mt6835_sim_t *psim = (nagi_mt6835_sim_t *)ctx;
+  if (psim == NULL || tx_data == NULL || rx_data == NULL) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  psim->stats.read_write_calls++;
+  psim->stats.bytes += (uint32_t)size;
+
+  for (size_t i = 0; i < size; i++) {
+    // Bytes clocked while deselected are not seen by the chip.
+    rx_data[i] = psim->cs ? sim_clock_byte(psim, tx_data[i]) : 0xFF;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+void nagi_mt6835_sim_delay(uint32_t ms) {
+  (void)ms;
+}
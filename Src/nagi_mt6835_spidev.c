@@ -0,0 +1,385 @@
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "nagi_mt6835_spidev.h"
+
+#if defined(__linux__)
+
+#include "nagi_mt6835_sim.h"
+
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+
+#define SPIDEV_PROFILE_REG(regs, reg) ((regs)[(reg) - NAGI_MT6835_SHADOW_REG_FIRST])
+
+/// @brief Run an ioctl on the node.
+/// @param pspidev spidev transport.
+/// @param request ioctl request.
+/// @param arg ioctl argument.
+/// @return ioctl result.
+static int spidev_ioctl(nagi_mt6835_spidev_t *pspidev, unsigned long request, void *arg) {
+  pspidev->ioctl_calls++;
+  if (pspidev->ioctl_fn != NULL) {
+    return pspidev->ioctl_fn(pspidev->ioctl_ctx, pspidev->fd, request, arg);
+  }
+  return ioctl(pspidev->fd, request, arg);
+}
+
+/// @brief Fill one transfer of a message.
+/// @param pspidev spidev transport.
+/// @param ptransfer transfer.
+/// @param tx_data tx data.
+/// @param rx_data rx data.
+/// @param size transfer size.
+/// @param cs_change release the chip select after this transfer.
+static void spidev_fill_transfer(
+  const nagi_mt6835_spidev_t *pspidev,
+  struct spi_ioc_transfer *ptransfer,
+  uint8_t *tx_data,
+  uint8_t *rx_data,
+  size_t size,
+  bool cs_change
+) {
+  memset(ptransfer, 0, sizeof(*ptransfer));
+  ptransfer->tx_buf = (uintptr_t)tx_data;
+  ptransfer->rx_buf = (uintptr_t)rx_data;
+  ptransfer->len = (uint32_t)size;
+  ptransfer->speed_hz = pspidev->speed_hz;
+  ptransfer->bits_per_word = 8;
+  ptransfer->cs_change = cs_change ? 1 : 0;
+}
+
+/// @brief Get the spidev transport of a handle.
+/// @param pmt6835 mt6835 handle.
+/// @return spidev transport, NULL if the handle is not configured for spidev.
+static nagi_mt6835_spidev_t *spidev_of(const nagi_mt6835_t *pmt6835) {
+  if (pmt6835->read_write_ctx_fn != nagi_mt6835_spidev_read_write_ctx) {
+    return NULL;
+  }
+  return (nagi_mt6835_spidev_t *)pmt6835->user_ctx;
+}
+
+/// @brief Chip select function, the kernel frames every transfer.
+/// @param ctx spidev transport.
+/// @param select select.
+static void spidev_chip_select(void *ctx, bool select) {
+  (void)ctx;
+  (void)select;
+}
+
+/// @brief Delay function.
+/// @param ms delay in ms.
+static void spidev_delay(uint32_t ms) {
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_init(nagi_mt6835_spidev_t *pspidev, const nagi_mt6835_spidev_config_t *pconfig) {
+  if (pspidev == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (pconfig->fd < 0 || pconfig->speed_hz == 0) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  memset(pspidev, 0, sizeof(*pspidev));
+  pspidev->fd = pconfig->fd;
+  pspidev->speed_hz = pconfig->speed_hz;
+  pspidev->ioctl_fn = pconfig->ioctl_fn;
+  pspidev->ioctl_ctx = pconfig->ioctl_ctx;
+
+  uint8_t mode = SPI_MODE_3;
+  uint8_t bits = 8;
+  uint32_t speed_hz = pconfig->speed_hz;
+  if (spidev_ioctl(pspidev, SPI_IOC_WR_MODE, &mode) < 0 ||
+      spidev_ioctl(pspidev, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+      spidev_ioctl(pspidev, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_make_config(
+  nagi_mt6835_spidev_t *pspidev,
+  nagi_mt6835_config_t *pconfig,
+  bool enable_crc_check
+) {
+  if (pspidev == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pconfig == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  memset(pconfig, 0, sizeof(*pconfig));
+  pconfig->chip_select_ctx_fn = spidev_chip_select;
+  pconfig->read_write_ctx_fn = nagi_mt6835_spidev_read_write_ctx;
+  pconfig->delay_fn = spidev_delay;
+  pconfig->user_ctx = pspidev;
+  pconfig->enable_crc_check = enable_crc_check;
+
+  return NAGI_MT6835_OK;
+}
+
+int nagi_mt6835_spidev_read_write_ctx(void *ctx, uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  nagi_mt6835_spidev_t *pspidev = (nagi_mt6835_spidev_t *)ctx;
+  if (pspidev == NULL || tx_data == NULL || rx_data == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  struct spi_ioc_transfer transfer;
+  spidev_fill_transfer(pspidev, &transfer, tx_data, rx_data, size, false);
+  if (spidev_ioctl(pspidev, SPI_IOC_MESSAGE(1), &transfer) < 0) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_queue(
+  nagi_mt6835_spidev_t *pspidev,
+  nagi_mt6835_t *pmt6835,
+  nagi_mt6835_async_req_t *preq
+) {
+  if (pspidev == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pmt6835 == NULL || preq == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  if (preq->size == 0 || preq->size > NAGI_MT6835_ASYNC_FRAME_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+  if (pspidev->count == NAGI_MT6835_SPIDEV_BATCH_MAX) {
+    return NAGI_MT6835_ERROR;
+  }
+
+  pspidev->reqs[pspidev->count] = preq;
+  pspidev->devices[pspidev->count] = pmt6835;
+  pspidev->count++;
+  preq->result = NAGI_MT6835_OK;
+  preq->state = NAGI_MT6835_ASYNC_STATE_QUEUED;
+
+  return NAGI_MT6835_OK;
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_flush(nagi_mt6835_spidev_t *pspidev) {
+  if (pspidev == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+
+  const size_t count = pspidev->count;
+  if (count == 0) {
+    return NAGI_MT6835_OK;
+  }
+
+  // Completion functions may queue the next batch, work on a copy.
+  nagi_mt6835_async_req_t *reqs[NAGI_MT6835_SPIDEV_BATCH_MAX];
+  nagi_mt6835_t *devices[NAGI_MT6835_SPIDEV_BATCH_MAX];
+  memcpy(reqs, pspidev->reqs, count * sizeof(reqs[0]));
+  memcpy(devices, pspidev->devices, count * sizeof(devices[0]));
+
+  for (size_t i = 0; i < count; i++) {
+    nagi_mt6835_async_req_t *preq = reqs[i];
+    spidev_fill_transfer(pspidev, &pspidev->transfers[i], preq->tx_data, preq->rx_data, preq->size, i + 1 < count);
+    preq->state = NAGI_MT6835_ASYNC_STATE_IN_FLIGHT;
+  }
+  const int ret = spidev_ioctl(pspidev, SPI_IOC_MESSAGE(count), pspidev->transfers);
+  pspidev->count = 0;
+
+  nagi_mt6835_error_t first_err = NAGI_MT6835_OK;
+  for (size_t i = 0; i < count; i++) {
+    reqs[i]->result = ret < 0 ? NAGI_MT6835_ERROR : NAGI_MT6835_OK;
+    nagi_mt6835_error_t err = nagi_mt6835_async_complete(devices[i], reqs[i]);
+    if (first_err == NAGI_MT6835_OK) {
+      first_err = err;
+    }
+  }
+
+  return first_err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_poll_angles(
+  nagi_mt6835_t **devices,
+  nagi_mt6835_async_req_t *reqs,
+  size_t count
+) {
+  if (devices == NULL || reqs == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (devices[i] == NULL) {
+      return NAGI_MT6835_HANDLE_NULL;
+    }
+    if (spidev_of(devices[i]) == NULL) {
+      return NAGI_MT6835_INVALID_ARGUMENT;
+    }
+  }
+
+  nagi_mt6835_error_t first_err = NAGI_MT6835_OK;
+  for (size_t i = 0; i < count; i++) {
+    nagi_mt6835_spidev_t *pspidev = spidev_of(devices[i]);
+    nagi_mt6835_error_t err = NAGI_MT6835_OK;
+    if (pspidev->count == NAGI_MT6835_SPIDEV_BATCH_MAX) {
+      err = nagi_mt6835_spidev_flush(pspidev);
+    }
+    if (err == NAGI_MT6835_OK) {
+      memset(&reqs[i], 0, sizeof(reqs[i]));
+      nagi_mt6835_async_prepare_get_raw_angle(devices[i], &reqs[i]);
+      err = nagi_mt6835_spidev_queue(pspidev, devices[i], &reqs[i]);
+    }
+    if (first_err == NAGI_MT6835_OK) {
+      first_err = err;
+    }
+  }
+
+  // Flushing an emptied node again does nothing, so every node goes out once.
+  for (size_t i = 0; i < count; i++) {
+    nagi_mt6835_error_t err = nagi_mt6835_spidev_flush(spidev_of(devices[i]));
+    if (first_err == NAGI_MT6835_OK) {
+      first_err = err;
+    }
+  }
+
+  return first_err;
+}
+
+nagi_mt6835_error_t nagi_mt6835_spidev_apply_profile(
+  nagi_mt6835_t *pmt6835,
+  const nagi_mt6835_profile_t *pprofile,
+  bool program_eeprom,
+  nagi_mt6835_profile_result_t *presult
+) {
+  if (pmt6835 == NULL) {
+    return NAGI_MT6835_HANDLE_NULL;
+  }
+  if (pprofile == NULL) {
+    return NAGI_MT6835_POINTER_NULL;
+  }
+
+  nagi_mt6835_spidev_t *pspidev = spidev_of(pmt6835);
+  if (pspidev == NULL || pspidev->count + NAGI_MT6835_SHADOW_REG_COUNT + 1 > NAGI_MT6835_SPIDEV_BATCH_MAX) {
+    return NAGI_MT6835_INVALID_ARGUMENT;
+  }
+
+  nagi_mt6835_profile_result_t result = {0};
+  if (presult != NULL) {
+    *presult = result;
+  }
+
+  nagi_mt6835_error_t err = nagi_mt6835_profile_validate(pprofile);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  // One burst read of the whole configuration into a local, the shadow cache stays opt-in.
+  uint8_t cur_regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  err = nagi_mt6835_read_regs(pmt6835, NAGI_MT6835_SHADOW_REG_FIRST, cur_regs, NAGI_MT6835_SHADOW_REG_COUNT);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+
+  uint8_t target_regs[NAGI_MT6835_SHADOW_REG_COUNT];
+  uint16_t diff_mask = 0;
+  err = nagi_mt6835_profile_build(pprofile, cur_regs, target_regs, &diff_mask);
+  if (err != NAGI_MT6835_OK) {
+    return err;
+  }
+  if (diff_mask == 0) {
+    return NAGI_MT6835_OK;
+  }
+
+  // Ascending order keeps the high byte of ABZ_RES and ZERO written before the low byte, the
+  // EEPROM program goes last in the same message.
+  nagi_mt6835_async_req_t reqs[NAGI_MT6835_SHADOW_REG_COUNT + 1];
+  size_t count = 0;
+  for (int reg = NAGI_MT6835_SHADOW_REG_FIRST; reg <= NAGI_MT6835_SHADOW_REG_LAST; reg++) {
+    if ((diff_mask & (1u << reg)) == 0) {
+      continue;
+    }
+    nagi_mt6835_async_req_t *preq = &reqs[count++];
+    memset(preq, 0, sizeof(*preq));
+    nagi_mt6835_async_prepare_write_reg(pmt6835, preq, (nagi_mt6835_reg_enum_t)reg, SPIDEV_PROFILE_REG(target_regs, reg));
+    nagi_mt6835_spidev_queue(pspidev, pmt6835, preq);
+  }
+  nagi_mt6835_async_req_t *peeprom = NULL;
+  if (program_eeprom) {
+    peeprom = &reqs[count];
+    memset(peeprom, 0, sizeof(*peeprom));
+    nagi_mt6835_async_prepare_program_eeprom(pmt6835, peeprom);
+    nagi_mt6835_spidev_queue(pspidev, pmt6835, peeprom);
+  }
+
+  err = nagi_mt6835_spidev_flush(pspidev);
+
+  for (size_t i = 0; i < count; i++) {
+    if (reqs[i].result == NAGI_MT6835_OK) {
+      result.written_mask |= 1u << reqs[i].reg;
+      result.write_count++;
+    }
+  }
+  if (peeprom != NULL) {
+    result.eeprom_programmed = peeprom->result == NAGI_MT6835_OK && result.write_count == count;
+  }
+
+  if (presult != NULL) {
+    *presult = result;
+  }
+  return err;
+}
+
+int nagi_mt6835_spidev_sim_ioctl(void *ctx, int fd, unsigned long request, void *arg) {
+  (void)fd;
+  nagi_mt6835_sim_t *psim = (nagi_mt6835_sim_t *)ctx;
+  if (psim == NULL || arg == NULL) {
+    return -1;
+  }
+
+  if (request == SPI_IOC_WR_MODE || request == SPI_IOC_WR_BITS_PER_WORD || request == SPI_IOC_WR_MAX_SPEED_HZ) {
+    return 0;
+  }
+  if (_IOC_TYPE(request) != SPI_IOC_MAGIC || _IOC_NR(request) != 0 || _IOC_DIR(request) != _IOC_WRITE ||
+      _IOC_SIZE(request) % sizeof(struct spi_ioc_transfer) != 0) {
+    return -1;
+  }
+
+  const struct spi_ioc_transfer *transfers = (const struct spi_ioc_transfer *)arg;
+  const size_t count = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+  int total = 0;
+  for (size_t i = 0; i < count; i++) {
+    const struct spi_ioc_transfer *ptransfer = &transfers[i];
+    if (ptransfer->tx_buf == 0 || ptransfer->rx_buf == 0) {
+      return -1;
+    }
+
+    nagi_mt6835_sim_chip_select_ctx(psim, true);
+    if (nagi_mt6835_sim_read_write_ctx(
+          psim,
+          (uint8_t *)(uintptr_t)ptransfer->tx_buf,
+          (uint8_t *)(uintptr_t)ptransfer->rx_buf,
+          ptransfer->len
+        ) != NAGI_MT6835_OK) {
+      nagi_mt6835_sim_chip_select_ctx(psim, false);
+      return -1;
+    }
+    total += (int)ptransfer->len;
+
+    // cs_change releases the chip select between transfers, on the last one it would keep it.
+    const bool last = i + 1 == count;
+    if (last != (ptransfer->cs_change != 0)) {
+      nagi_mt6835_sim_chip_select_ctx(psim, false);
+    }
+  }
+
+  return total;
+}
+
+#endif // __linux__
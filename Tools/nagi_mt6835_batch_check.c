@@ -0,0 +1,21 @@
+/// Bit exactness check of the nagi_mt6835_batch.h CRC kernel against nagi_mt6835_crc8_table.
+///
+/// nagi_mt6835_batch_check
+///
+/// Runs nagi_mt6835_batch_verify_kernel, every one of the 2^24 angle byte combinations with the
+/// reference CRC and with one CRC bit flipped, and exits with 1 on any mismatching frame. The
+/// kernel is picked at compile time, build once per target flags, e.g. add -mssse3 for the SSSE3
+/// kernel.
+///
+/// cc -O2 -IInc Tools/nagi_mt6835_batch_check.c Src/nagi_mt6835_batch.c Src/nagi_mt6835.c -lm
+
+#include "nagi_mt6835_batch.h"
+
+#include <stdio.h>
+
+int main(void) {
+  const uint32_t mismatches = nagi_mt6835_batch_verify_kernel();
+
+  printf("kernel %s, mismatches %u\n", nagi_mt6835_batch_kernel_name(), mismatches);
+  return mismatches != 0 ? 1 : 0;
+}
@@ -0,0 +1,857 @@
+/// Benchmark of the public driver API against the simulator as an in memory bus.
+///
+/// nagi_mt6835_bench [--json <out>] [--compare <baseline> [--threshold <percent>]] [--filter <text>]
+///
+/// Reports ns/op, cycles/op, SPI transactions/op and bytes/op for every case. The JSON file holds
+/// one case per line:
+///
+///   {"name": "get_raw_angle/continue/crc", "ns_per_op": 41.2, "transactions_per_op": 1, ...},
+///
+/// fast_get_raw_angle/crc runs the static path of nagi_mt6835_fast.h on the same bus, compare it
+/// with get_raw_angle/continue/crc. filter_push_frame/crc is the per-frame ISR cost of the
+/// nagi_mt6835_filter.h stages on top of continuous_read_decode/crc. foc_update_q15 and
+/// foc_update_f32 are the table sin / cos of nagi_mt6835_foc.h, foc_libm_f32 is the float path
+/// they replace, rad * pole pairs, fmodf, sinf and cosf. The observer cases track a constant speed
+/// at BENCH_SAMPLE_HZ and extrapolate half a sample period ahead. fold_soft_zero sets a new
+/// software zero before every fold, two register reads and two writes, 4 tx/op, or 2 tx/op with
+/// the shadow registers, are its bus cost to track.
+///
+/// Compare mode exits with 1 when any case does more transactions or bytes per op than the
+/// baseline, or gets slower than the baseline by more than the threshold, 10 % by default, or when
+/// a baseline case the filter does not exclude is missing from the run.
+///
+/// cc -O2 -IInc Tools/nagi_mt6835_bench.c Src/nagi_mt6835.c Src/nagi_mt6835_filter.c Src/nagi_mt6835_foc.c
+///   Src/nagi_mt6835_observer.c Src/nagi_mt6835_sim.c -lm
+
+#include "nagi_mt6835.h"
+#include "nagi_mt6835_filter.h"
+#include "nagi_mt6835_foc.h"
+#include "nagi_mt6835_observer.h"
+#include "nagi_mt6835_sim.h"
+
+// Static fast path bound to the simulator, compared with the generic path.
+#define NAGI_MT6835_FAST_CRC                           (1)
+#define NAGI_MT6835_FAST_CHIP_SELECT(ctx, select)      nagi_mt6835_sim_chip_select_ctx((ctx), (select))
+#define NAGI_MT6835_FAST_READ_WRITE(ctx, tx, rx, size) nagi_mt6835_sim_read_write_ctx((ctx), (tx), (rx), (size))
+#include "nagi_mt6835_fast.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define BENCH_CASE_MAX   (128)
+#define BENCH_REPEAT     (5)
+#define BENCH_RUN_NS     (20000000.0)
+#define BENCH_NAME_SIZE  (64)
+#define BENCH_POLE_PAIRS (7)
+#define BENCH_TIMER_HZ   (1000000)
+#define BENCH_SAMPLE_HZ  (20000)
+#define BENCH_TICKS      (BENCH_TIMER_HZ / BENCH_SAMPLE_HZ)
+
+/// @brief Benchmark fixture, one simulator and handle per case.
+typedef struct bench_fixture_t {
+  /// @brief Simulator.
+  nagi_mt6835_sim_t sim;
+  /// @brief mt6835 handle.
+  nagi_mt6835_t mt6835;
+  /// @brief Continuous read rx frame.
+  uint8_t rx_frame[6];
+  /// @brief Sample filter, every stage on.
+  nagi_mt6835_filter_t filter;
+  /// @brief Float observer.
+  nagi_mt6835_observer_f32_t observer_f32;
+  /// @brief Fixed point observer.
+  nagi_mt6835_observer_q32_t observer_q32;
+  /// @brief Loop counter, varies the setter arguments.
+  uint32_t counter;
+} bench_fixture_t;
+
+/// @brief Benchmark case function typedef, runs one operation.
+typedef void (*bench_fn_t)(bench_fixture_t *);
+
+/// @brief Benchmark case.
+typedef struct bench_case_t {
+  /// @brief Case name.
+  const char *name;
+  /// @brief Enable CRC check.
+  bool enable_crc_check;
+  /// @brief Sync the shadow registers before running.
+  bool shadow;
+  /// @brief Operation.
+  bench_fn_t fn;
+} bench_case_t;
+
+/// @brief Benchmark result.
+typedef struct bench_result_t {
+  /// @brief Case name.
+  char name[BENCH_NAME_SIZE];
+  /// @brief Time per operation in ns.
+  double ns_per_op;
+  /// @brief SPI transactions per operation.
+  double transactions_per_op;
+  /// @brief SPI bytes per operation.
+  double bytes_per_op;
+  /// @brief CPU cycles per operation, 0 where no cycle counter is read.
+  double cycles_per_op;
+} bench_result_t;
+
+/// @brief Keeps results alive so the compiler can not drop the calls.
+static volatile uint32_t bench_sink;
+
+static void bench_get_raw_angle_normal(bench_fixture_t *pfixture) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_get_raw_angle(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_NORMAL, &raw_angle);
+  bench_sink = raw_angle;
+}
+
+static void bench_get_raw_angle_continue(bench_fixture_t *pfixture) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_get_raw_angle(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &raw_angle);
+  bench_sink = raw_angle;
+}
+
+static void bench_fast_get_raw_angle(bench_fixture_t *pfixture) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_warning_t warning = NAGI_MT6835_WARN_NONE;
+  nagi_mt6835_fast_get_raw_angle(&pfixture->sim, &raw_angle, &warning);
+  bench_sink = raw_angle;
+}
+
+static void bench_get_angle(bench_fixture_t *pfixture) {
+  float angle = 0.0f;
+  nagi_mt6835_get_angle(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &angle);
+  bench_sink = (uint32_t)angle;
+}
+
+static void bench_get_angle_q31(bench_fixture_t *pfixture) {
+  int32_t angle = 0;
+  nagi_mt6835_get_angle_q31(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &angle);
+  bench_sink = (uint32_t)angle;
+}
+
+static void bench_get_angle_u16(bench_fixture_t *pfixture) {
+  uint16_t angle = 0;
+  nagi_mt6835_get_angle_u16(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &angle);
+  bench_sink = angle;
+}
+
+static void bench_get_angle_unit(bench_fixture_t *pfixture) {
+  nagi_mt6835_angle_t angle = 0;
+  nagi_mt6835_get_angle_unit(&pfixture->mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &angle);
+  bench_sink = (uint32_t)angle;
+}
+
+static void bench_get_raw_zero_angle(bench_fixture_t *pfixture) {
+  uint16_t raw_zero_angle = 0;
+  nagi_mt6835_get_raw_zero_angle(&pfixture->mt6835, &raw_zero_angle);
+  bench_sink = raw_zero_angle;
+}
+
+static void bench_get_zero_angle(bench_fixture_t *pfixture) {
+  float rad = 0.0f;
+  nagi_mt6835_get_zero_angle(&pfixture->mt6835, &rad);
+  bench_sink = (uint32_t)rad;
+}
+
+static void bench_set_zero_angle(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_zero_angle(&pfixture->mt6835, (float)(pfixture->counter++ & 0xFF) * 0.01f);
+}
+
+static void bench_set_id(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_id(&pfixture->mt6835, (uint8_t)pfixture->counter++);
+}
+
+static void bench_get_id(bench_fixture_t *pfixture) {
+  uint8_t id = 0;
+  nagi_mt6835_get_id(&pfixture->mt6835, &id);
+  bench_sink = id;
+}
+
+static void bench_enable_abz_output(bench_fixture_t *pfixture) {
+  nagi_mt6835_enable_abz_output(&pfixture->mt6835, (pfixture->counter++ & 1) != 0);
+}
+
+static void bench_set_abz_ab_swap(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_ab_swap(&pfixture->mt6835, (pfixture->counter++ & 1) != 0);
+}
+
+static void bench_set_abz_resolution(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_resolution(&pfixture->mt6835, (uint16_t)(pfixture->counter++ & 0x3FFF));
+}
+
+static void bench_set_abz_z_position(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_z_position(&pfixture->mt6835, (uint16_t)(pfixture->counter++ & 0xFFF));
+}
+
+static void bench_set_abz_z_edge_up(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_z_edge_up(&pfixture->mt6835, (pfixture->counter++ & 1) != 0);
+}
+
+static void bench_set_abz_z_pulse_width(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_z_pulse_width(&pfixture->mt6835, (uint8_t)(pfixture->counter++ & 0x7));
+}
+
+static void bench_set_abz_z_phase(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_abz_z_phase(&pfixture->mt6835, (uint8_t)(pfixture->counter++ & 0x3));
+}
+
+static void bench_auto_zero_angle(bench_fixture_t *pfixture) {
+  nagi_mt6835_auto_zero_angle(&pfixture->mt6835);
+}
+
+static void bench_program_eeprom(bench_fixture_t *pfixture) {
+  nagi_mt6835_program_eeprom(&pfixture->mt6835);
+}
+
+static void bench_read_reg(bench_fixture_t *pfixture) {
+  uint8_t data = 0;
+  nagi_mt6835_read_reg(&pfixture->mt6835, NAGI_MT6835_REG_ABZ_RES1, &data);
+  bench_sink = data;
+}
+
+static void bench_write_reg(bench_fixture_t *pfixture) {
+  nagi_mt6835_write_reg(&pfixture->mt6835, NAGI_MT6835_REG_ID, (uint8_t)pfixture->counter++);
+}
+
+static void bench_read_regs(bench_fixture_t *pfixture) {
+  uint8_t data[NAGI_MT6835_BURST_MAX];
+  nagi_mt6835_read_regs(&pfixture->mt6835, NAGI_MT6835_REG_ID, data, NAGI_MT6835_SHADOW_REG_COUNT);
+  bench_sink = data[0];
+}
+
+static void bench_write_regs(bench_fixture_t *pfixture) {
+  const uint8_t data[2] = {(uint8_t)pfixture->counter, (uint8_t)(pfixture->counter >> 8)};
+  pfixture->counter++;
+  nagi_mt6835_write_regs(&pfixture->mt6835, NAGI_MT6835_REG_ABZ_RES2, data, 2);
+}
+
+static void bench_sync_shadow_regs(bench_fixture_t *pfixture) {
+  nagi_mt6835_sync_shadow_regs(&pfixture->mt6835);
+}
+
+static void bench_invalidate_shadow_regs(bench_fixture_t *pfixture) {
+  nagi_mt6835_invalidate_shadow_regs(&pfixture->mt6835);
+}
+
+static void bench_custom_continuous_read(bench_fixture_t *pfixture) {
+  uint8_t tx_data[6] = {0};
+  uint32_t raw_angle = 0;
+  nagi_mt6835_custom_continuous_read_begin(&pfixture->mt6835, tx_data, sizeof(tx_data));
+  nagi_mt6835_custom_continuous_read_end_raw(&pfixture->mt6835, pfixture->rx_frame, sizeof(pfixture->rx_frame), &raw_angle);
+  bench_sink = raw_angle;
+}
+
+static void bench_custom_continuous_read_end(bench_fixture_t *pfixture) {
+  float angle = 0.0f;
+  nagi_mt6835_custom_continuous_read_end(&pfixture->mt6835, pfixture->rx_frame, sizeof(pfixture->rx_frame), &angle);
+  bench_sink = (uint32_t)angle;
+}
+
+static void bench_continuous_read_decode(bench_fixture_t *pfixture) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_warning_t warning = NAGI_MT6835_WARN_NONE;
+  nagi_mt6835_continuous_read_decode(pfixture->rx_frame, pfixture->mt6835.enable_crc_check, &raw_angle, &warning);
+  bench_sink = raw_angle;
+}
+
+static void bench_filter_push_frame(bench_fixture_t *pfixture) {
+  uint32_t raw_angle = 0;
+  nagi_mt6835_filter_push_frame(&pfixture->filter, pfixture->rx_frame, pfixture->mt6835.enable_crc_check, &raw_angle);
+  bench_sink = raw_angle;
+}
+
+/// @brief Run a prepared request frame by hand and complete it.
+static void bench_async_run(bench_fixture_t *pfixture, nagi_mt6835_async_req_t *preq) {
+  nagi_mt6835_sim_chip_select_ctx(&pfixture->sim, true);
+  nagi_mt6835_sim_read_write_ctx(&pfixture->sim, preq->tx_data, preq->rx_data, preq->size);
+  nagi_mt6835_sim_chip_select_ctx(&pfixture->sim, false);
+  nagi_mt6835_async_complete(&pfixture->mt6835, preq);
+}
+
+static void bench_async_get_raw_angle(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_get_raw_angle(&pfixture->mt6835, &req);
+  bench_async_run(pfixture, &req);
+  bench_sink = req.raw_angle;
+}
+
+static void bench_async_auto_zero_angle(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_auto_zero_angle(&pfixture->mt6835, &req);
+  bench_async_run(pfixture, &req);
+  bench_sink = (uint32_t)req.result;
+}
+
+static void bench_async_program_eeprom(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_program_eeprom(&pfixture->mt6835, &req);
+  bench_async_run(pfixture, &req);
+  bench_sink = (uint32_t)req.result;
+}
+
+static void bench_async_idle(bench_fixture_t *pfixture) {
+  bench_sink = nagi_mt6835_async_idle(&pfixture->mt6835);
+}
+
+/// @brief Transfer start function for the submit cases, the simulator answers at once.
+static int bench_start_transfer(void *ctx, uint8_t *tx_data, uint8_t *rx_data, size_t size) {
+  return nagi_mt6835_sim_read_write_ctx(ctx, tx_data, rx_data, size);
+}
+
+static void bench_async_submit_get_raw_angle(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_get_raw_angle(&pfixture->mt6835, &req);
+  nagi_mt6835_async_submit(&pfixture->mt6835, &req);
+  nagi_mt6835_async_transfer_done(&pfixture->mt6835, 0);
+  bench_sink = req.raw_angle;
+}
+
+static void bench_async_submit_read_reg(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_read_reg(&pfixture->mt6835, &req, NAGI_MT6835_REG_ABZ_RES1);
+  nagi_mt6835_async_submit(&pfixture->mt6835, &req);
+  nagi_mt6835_async_transfer_done(&pfixture->mt6835, 0);
+  bench_sink = req.data;
+}
+
+static void bench_async_submit_write_reg(bench_fixture_t *pfixture) {
+  nagi_mt6835_async_req_t req;
+  memset(&req, 0, sizeof(req));
+  nagi_mt6835_async_prepare_write_reg(&pfixture->mt6835, &req, NAGI_MT6835_REG_ID, (uint8_t)pfixture->counter++);
+  nagi_mt6835_async_submit(&pfixture->mt6835, &req);
+  nagi_mt6835_async_transfer_done(&pfixture->mt6835, 0);
+}
+
+static uint32_t bench_correct(void *ctx, uint32_t raw_angle) {
+  (void)ctx;
+  return raw_angle ^ 1u;
+}
+
+static void bench_sample(void *ctx, const nagi_mt6835_sample_t *psample) {
+  (void)ctx;
+  bench_sink = psample->raw_angle;
+}
+
+static void bench_get_raw_angle_hooks(bench_fixture_t *pfixture) {
+  if (pfixture->counter++ == 0) {
+    nagi_mt6835_set_angle_correction(&pfixture->mt6835, bench_correct, NULL);
+    nagi_mt6835_set_sample_hook(&pfixture->mt6835, bench_sample, NULL);
+  }
+  bench_get_raw_angle_continue(pfixture);
+}
+
+static void bench_set_angle_correction(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_angle_correction(&pfixture->mt6835, (pfixture->counter++ & 1) != 0 ? bench_correct : NULL, NULL);
+}
+
+static void bench_set_soft_zero(bench_fixture_t *pfixture) {
+  const uint32_t counter = pfixture->counter++;
+  const uint32_t raw_zero = (counter * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  nagi_mt6835_set_soft_zero(&pfixture->mt6835, raw_zero, (counter & 1) != 0);
+}
+
+static void bench_shift_soft_zero(bench_fixture_t *pfixture) {
+  nagi_mt6835_shift_soft_zero(&pfixture->mt6835, (pfixture->counter++ * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1));
+}
+
+static void bench_get_soft_zero(bench_fixture_t *pfixture) {
+  uint32_t raw_zero = 0;
+  bool reverse = false;
+  nagi_mt6835_get_soft_zero(&pfixture->mt6835, &raw_zero, &reverse);
+  bench_sink = raw_zero + reverse;
+}
+
+static void bench_fold_soft_zero(bench_fixture_t *pfixture) {
+  // A new software zero every time, so every fold moves the chip zero.
+  bench_set_soft_zero(pfixture);
+  nagi_mt6835_fold_soft_zero(&pfixture->mt6835, false);
+}
+
+static void bench_set_recovery(bench_fixture_t *pfixture) {
+  const nagi_mt6835_recovery_t recovery = {
+    .max_retries = (uint8_t)(pfixture->counter++ & 3),
+    .fallback = NAGI_MT6835_FALLBACK_LAST_GOOD,
+    .max_fallbacks = 4,
+  };
+  nagi_mt6835_set_recovery(&pfixture->mt6835, &recovery);
+}
+
+static void bench_set_sample_hook(bench_fixture_t *pfixture) {
+  nagi_mt6835_set_sample_hook(&pfixture->mt6835, (pfixture->counter++ & 1) != 0 ? bench_sample : NULL, NULL);
+}
+
+static void bench_add_remove_sample_hook(bench_fixture_t *pfixture) {
+  if ((pfixture->counter++ & 1) != 0) {
+    nagi_mt6835_add_sample_hook(&pfixture->mt6835, bench_sample, NULL);
+  } else {
+    nagi_mt6835_remove_sample_hook(&pfixture->mt6835, bench_sample, NULL);
+  }
+}
+
+static void bench_get_stats(bench_fixture_t *pfixture) {
+  nagi_mt6835_stats_t stats;
+  bench_sink = (uint32_t)nagi_mt6835_get_stats(&pfixture->mt6835, &stats);
+}
+
+static void bench_reset_stats(bench_fixture_t *pfixture) {
+  bench_sink = (uint32_t)nagi_mt6835_reset_stats(&pfixture->mt6835);
+}
+
+static void bench_raw_to_angle(bench_fixture_t *pfixture) {
+  bench_sink = (uint32_t)nagi_mt6835_raw_to_angle(pfixture->counter++ & (NAGI_MT6835_ANGLE_RESOLUTION - 1));
+}
+
+static void bench_foc_update_q15(bench_fixture_t *pfixture) {
+  const nagi_mt6835_foc_t foc = {BENCH_POLE_PAIRS, 0};
+  nagi_mt6835_foc_q15_t out;
+  nagi_mt6835_foc_update_q15(&foc, (pfixture->counter++ * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1), &out);
+  bench_sink = out.angle + (uint16_t)out.sin + (uint16_t)out.cos;
+}
+
+static void bench_foc_update_f32(bench_fixture_t *pfixture) {
+  const nagi_mt6835_foc_t foc = {BENCH_POLE_PAIRS, 0};
+  nagi_mt6835_foc_f32_t out;
+  nagi_mt6835_foc_update_f32(&foc, (pfixture->counter++ * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1), &out);
+  bench_sink = (uint32_t)(out.angle + out.sin + out.cos);
+}
+
+static void bench_foc_libm_f32(bench_fixture_t *pfixture) {
+  const uint32_t raw_angle = (pfixture->counter++ * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  const float angle = fmodf(nagi_mt6835_raw_to_rad_f32(raw_angle) * BENCH_POLE_PAIRS, 6.28318530718f);
+  bench_sink = (uint32_t)(angle + sinf(angle) + cosf(angle));
+}
+
+static void bench_observer_f32_update(bench_fixture_t *pfixture) {
+  const uint32_t sample = ++pfixture->counter;
+  nagi_mt6835_observer_f32_update(
+    &pfixture->observer_f32,
+    (sample * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1),
+    sample * BENCH_TICKS
+  );
+}
+
+static void bench_observer_f32_extrapolate(bench_fixture_t *pfixture) {
+  float angle;
+  nagi_mt6835_observer_f32_extrapolate(&pfixture->observer_f32, BENCH_TICKS / 2, &angle);
+  bench_sink = (uint32_t)angle;
+}
+
+static void bench_observer_q32_update(bench_fixture_t *pfixture) {
+  const uint32_t sample = ++pfixture->counter;
+  nagi_mt6835_observer_q32_update(
+    &pfixture->observer_q32,
+    (sample * 997) & (NAGI_MT6835_ANGLE_RESOLUTION - 1),
+    sample * BENCH_TICKS
+  );
+}
+
+static void bench_observer_q32_extrapolate(bench_fixture_t *pfixture) {
+  uint32_t angle;
+  nagi_mt6835_observer_q32_extrapolate(&pfixture->observer_q32, BENCH_TICKS / 2, &angle);
+  bench_sink = angle;
+}
+
+static const bench_case_t bench_cases[] = {
+  {"get_raw_angle/normal/crc", true, false, bench_get_raw_angle_normal},
+  {"get_raw_angle/normal/nocrc", false, false, bench_get_raw_angle_normal},
+  {"get_raw_angle/continue/crc", true, false, bench_get_raw_angle_continue},
+  {"get_raw_angle/continue/nocrc", false, false, bench_get_raw_angle_continue},
+  {"fast_get_raw_angle/crc", true, false, bench_fast_get_raw_angle},
+  {"get_angle/continue/crc", true, false, bench_get_angle},
+  {"get_angle_q31/continue/crc", true, false, bench_get_angle_q31},
+  {"get_angle_u16/continue/crc", true, false, bench_get_angle_u16},
+  {"get_angle_unit/continue/crc", true, false, bench_get_angle_unit},
+  {"get_raw_zero_angle", true, false, bench_get_raw_zero_angle},
+  {"get_raw_zero_angle/shadow", true, true, bench_get_raw_zero_angle},
+  {"get_zero_angle", true, false, bench_get_zero_angle},
+  {"set_zero_angle", true, false, bench_set_zero_angle},
+  {"set_zero_angle/shadow", true, true, bench_set_zero_angle},
+  {"set_id", true, false, bench_set_id},
+  {"get_id", true, false, bench_get_id},
+  {"enable_abz_output", true, false, bench_enable_abz_output},
+  {"enable_abz_output/shadow", true, true, bench_enable_abz_output},
+  {"set_abz_ab_swap", true, false, bench_set_abz_ab_swap},
+  {"set_abz_ab_swap/shadow", true, true, bench_set_abz_ab_swap},
+  {"set_abz_resolution", true, false, bench_set_abz_resolution},
+  {"set_abz_resolution/shadow", true, true, bench_set_abz_resolution},
+  {"set_abz_z_position", true, false, bench_set_abz_z_position},
+  {"set_abz_z_position/shadow", true, true, bench_set_abz_z_position},
+  {"set_abz_z_edge_up", true, false, bench_set_abz_z_edge_up},
+  {"set_abz_z_edge_up/shadow", true, true, bench_set_abz_z_edge_up},
+  {"set_abz_z_pulse_width", true, false, bench_set_abz_z_pulse_width},
+  {"set_abz_z_pulse_width/shadow", true, true, bench_set_abz_z_pulse_width},
+  {"set_abz_z_phase", true, false, bench_set_abz_z_phase},
+  {"set_abz_z_phase/shadow", true, true, bench_set_abz_z_phase},
+  {"auto_zero_angle", true, false, bench_auto_zero_angle},
+  {"program_eeprom", true, false, bench_program_eeprom},
+  {"read_reg", true, false, bench_read_reg},
+  {"write_reg", true, false, bench_write_reg},
+  {"read_regs/14", true, false, bench_read_regs},
+  {"write_regs/2", true, false, bench_write_regs},
+  {"sync_shadow_regs", true, false, bench_sync_shadow_regs},
+  {"invalidate_shadow_regs", true, false, bench_invalidate_shadow_regs},
+  {"custom_continuous_read/crc", true, false, bench_custom_continuous_read},
+  {"custom_continuous_read/nocrc", false, false, bench_custom_continuous_read},
+  {"custom_continuous_read_end/crc", true, false, bench_custom_continuous_read_end},
+  {"continuous_read_decode/crc", true, false, bench_continuous_read_decode},
+  {"continuous_read_decode/nocrc", false, false, bench_continuous_read_decode},
+  {"filter_push_frame/crc", true, false, bench_filter_push_frame},
+  {"async_get_raw_angle/crc", true, false, bench_async_get_raw_angle},
+  {"async_auto_zero_angle", true, false, bench_async_auto_zero_angle},
+  {"async_program_eeprom", true, false, bench_async_program_eeprom},
+  {"async_idle", true, false, bench_async_idle},
+  {"async_submit/get_raw_angle/crc", true, false, bench_async_submit_get_raw_angle},
+  {"async_submit/read_reg", true, false, bench_async_submit_read_reg},
+  {"async_submit/write_reg", true, false, bench_async_submit_write_reg},
+  {"get_raw_angle/continue/crc/hooks", true, false, bench_get_raw_angle_hooks},
+  {"set_angle_correction", true, false, bench_set_angle_correction},
+  {"set_soft_zero", true, false, bench_set_soft_zero},
+  {"shift_soft_zero", true, false, bench_shift_soft_zero},
+  {"get_soft_zero", true, false, bench_get_soft_zero},
+  {"fold_soft_zero", true, false, bench_fold_soft_zero},
+  {"fold_soft_zero/shadow", true, true, bench_fold_soft_zero},
+  {"set_recovery", true, false, bench_set_recovery},
+  {"set_sample_hook", true, false, bench_set_sample_hook},
+  {"add_remove_sample_hook", true, false, bench_add_remove_sample_hook},
+  {"get_stats", true, false, bench_get_stats},
+  {"reset_stats", true, false, bench_reset_stats},
+  {"raw_to_angle", true, false, bench_raw_to_angle},
+  {"foc_update_q15", true, false, bench_foc_update_q15},
+  {"foc_update_f32", true, false, bench_foc_update_f32},
+  {"foc_libm_f32", true, false, bench_foc_libm_f32},
+  {"observer_f32_update", true, false, bench_observer_f32_update},
+  {"observer_f32_extrapolate", true, false, bench_observer_f32_extrapolate},
+  {"observer_q32_update", true, false, bench_observer_q32_update},
+  {"observer_q32_extrapolate", true, false, bench_observer_q32_extrapolate},
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+/// @brief Monotonic time in ns.
+/// @return time in ns.
+static double bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/// @brief CPU cycle counter.
+/// @return cycles, 0 where no cycle counter is read.
+static uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/// @brief Set up a fresh simulator and handle for a case.
+/// @param pfixture fixture.
+/// @param pcase case.
+/// @return 0 on success.
+static int bench_setup(bench_fixture_t *pfixture, const bench_case_t *pcase) {
+  nagi_mt6835_config_t config;
+  const nagi_mt6835_sim_trajectory_t trajectory = {NAGI_MT6835_SIM_TRAJECTORY_VELOCITY, 0, 997, NULL, NULL};
+
+  memset(pfixture, 0, sizeof(*pfixture));
+  if (nagi_mt6835_sim_init(&pfixture->sim) != NAGI_MT6835_OK ||
+      nagi_mt6835_sim_set_trajectory(&pfixture->sim, &trajectory) != NAGI_MT6835_OK ||
+      nagi_mt6835_sim_make_ctx_config(&pfixture->sim, &config, pcase->enable_crc_check) != NAGI_MT6835_OK) {
+    return -1;
+  }
+  config.start_transfer_ctx_fn = bench_start_transfer;
+  if (nagi_mt6835_init(&pfixture->mt6835, &config) != NAGI_MT6835_OK) {
+    return -1;
+  }
+  if (pcase->shadow && nagi_mt6835_sync_shadow_regs(&pfixture->mt6835) != NAGI_MT6835_OK) {
+    return -1;
+  }
+
+  const nagi_mt6835_filter_config_t filter_config = {NAGI_MT6835_FILTER_MEDIAN_MAX, 1000, 8, 4, true};
+  if (nagi_mt6835_filter_init(&pfixture->filter, &filter_config) != NAGI_MT6835_OK) {
+    return -1;
+  }
+
+  const nagi_mt6835_observer_config_t observer_config = {500.0f, BENCH_TIMER_HZ, BENCH_SAMPLE_HZ};
+  if (nagi_mt6835_observer_f32_init(&pfixture->observer_f32, &observer_config, 0, 0) != NAGI_MT6835_OK ||
+      nagi_mt6835_observer_q32_init(&pfixture->observer_q32, &observer_config, 0, 0) != NAGI_MT6835_OK) {
+    return -1;
+  }
+
+  // One captured frame for the custom continuous read cases.
+  uint8_t tx_frame[6] = NAGI_MT6835_CONTINUOUS_READ_TX_INIT;
+  nagi_mt6835_sim_chip_select_ctx(&pfixture->sim, true);
+  nagi_mt6835_sim_read_write_ctx(&pfixture->sim, tx_frame, pfixture->rx_frame, sizeof(tx_frame));
+  nagi_mt6835_sim_chip_select_ctx(&pfixture->sim, false);
+  return 0;
+}
+
+/// @brief Run one case, best of a few timed runs.
+/// @param pcase case.
+/// @param presult result.
+/// @return 0 on success.
+static int bench_run(const bench_case_t *pcase, bench_result_t *presult) {
+  static bench_fixture_t fixture;
+  if (bench_setup(&fixture, pcase) != 0) {
+    return -1;
+  }
+
+  // Size the run to about BENCH_RUN_NS.
+  uint32_t iterations = 1;
+  for (;;) {
+    const double start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+      pcase->fn(&fixture);
+    }
+    const double elapsed = bench_now_ns() - start;
+    if (elapsed > BENCH_RUN_NS / 10.0 || iterations >= (1u << 28)) {
+      iterations = (uint32_t)((double)iterations * BENCH_RUN_NS / (elapsed > 1.0 ? elapsed : 1.0)) + 1;
+      break;
+    }
+    iterations *= 2;
+  }
+
+  double best = 0.0;
+  double best_cycles = 0.0;
+  nagi_mt6835_sim_stats_t stats;
+  for (int repeat = 0; repeat < BENCH_REPEAT; repeat++) {
+    nagi_mt6835_sim_reset_stats(&fixture.sim);
+    const double start = bench_now_ns();
+    const uint64_t start_cycles = bench_cycles();
+    for (uint32_t i = 0; i < iterations; i++) {
+      pcase->fn(&fixture);
+    }
+    const uint64_t stop_cycles = bench_cycles();
+    const double ns_per_op = (bench_now_ns() - start) / (double)iterations;
+    if (repeat == 0 || ns_per_op < best) {
+      best = ns_per_op;
+      best_cycles = (double)(stop_cycles - start_cycles) / (double)iterations;
+    }
+  }
+  nagi_mt6835_sim_get_stats(&fixture.sim, &stats);
+
+  snprintf(presult->name, sizeof(presult->name), "%s", pcase->name);
+  presult->ns_per_op = best;
+  presult->transactions_per_op = (double)stats.transactions / (double)iterations;
+  presult->bytes_per_op = (double)stats.bytes / (double)iterations;
+  presult->cycles_per_op = best_cycles;
+  return 0;
+}
+
+/// @brief Write results as JSON, one case per line.
+/// @param path output path.
+/// @param results results.
+/// @param count result count.
+/// @return 0 on success.
+static int bench_write_json(const char *path, const bench_result_t *results, size_t count) {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  fprintf(file, "{\"benchmarks\": [\n");
+  for (size_t i = 0; i < count; i++) {
+    fprintf(
+      file,
+      "  {\"name\": \"%s\", \"ns_per_op\": %.3f, \"transactions_per_op\": %.3f, \"bytes_per_op\": %.3f, "
+      "\"cycles_per_op\": %.1f}%s\n",
+      results[i].name,
+      results[i].ns_per_op,
+      results[i].transactions_per_op,
+      results[i].bytes_per_op,
+      results[i].cycles_per_op,
+      i + 1 < count ? "," : ""
+    );
+  }
+  fprintf(file, "]}\n");
+
+  if (fclose(file) != 0) {
+    perror(path);
+    return -1;
+  }
+  return 0;
+}
+
+/// @brief Read results written by bench_write_json.
+/// @param path input path.
+/// @param results results, BENCH_CASE_MAX entries.
+/// @param pcount result count.
+/// @return 0 on success.
+static int bench_read_json(const char *path, bench_result_t *results, size_t *pcount) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  char line[256];
+  size_t count = 0;
+  while (count < BENCH_CASE_MAX && fgets(line, sizeof(line), file) != NULL) {
+    bench_result_t *presult = &results[count];
+    if (sscanf(
+          line,
+          " {\"name\": \"%63[^\"]\", \"ns_per_op\": %lf, \"transactions_per_op\": %lf, \"bytes_per_op\": %lf",
+          presult->name,
+          &presult->ns_per_op,
+          &presult->transactions_per_op,
+          &presult->bytes_per_op
+        ) == 4) {
+      count++;
+    }
+  }
+  fclose(file);
+
+  *pcount = count;
+  return 0;
+}
+
+/// @brief Compare results against a baseline.
+/// @param results results.
+/// @param count result count.
+/// @param baseline baseline results.
+/// @param baseline_count baseline result count.
+/// @param threshold allowed slowdown in percent.
+/// @param filter case name filter of the run, NULL for all cases.
+/// @return number of regressions, baseline cases missing from the run included.
+static int bench_compare(
+  const bench_result_t *results,
+  size_t count,
+  const bench_result_t *baseline,
+  size_t baseline_count,
+  double threshold,
+  const char *filter
+) {
+  int regressions = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const bench_result_t *pbase = NULL;
+    for (size_t k = 0; k < baseline_count; k++) {
+      if (strcmp(baseline[k].name, results[i].name) == 0) {
+        pbase = &baseline[k];
+        break;
+      }
+    }
+    if (pbase == NULL) {
+      printf("NEW   %-34s\n", results[i].name);
+      continue;
+    }
+
+    // Bus traffic is deterministic, any increase is a regression.
+    const bool more_traffic = results[i].transactions_per_op > pbase->transactions_per_op + 1e-6 ||
+                              results[i].bytes_per_op > pbase->bytes_per_op + 1e-6;
+    const bool slower = results[i].ns_per_op > pbase->ns_per_op * (1.0 + threshold / 100.0);
+    if (more_traffic || slower) {
+      regressions++;
+    }
+    printf(
+      "%s %-34s %10.1f -> %10.1f ns/op %+7.1f %%  %6.2f -> %6.2f tx/op  %7.2f -> %7.2f B/op\n",
+      more_traffic || slower ? "FAIL " : "ok   ",
+      results[i].name,
+      pbase->ns_per_op,
+      results[i].ns_per_op,
+      pbase->ns_per_op > 0.0 ? (results[i].ns_per_op / pbase->ns_per_op - 1.0) * 100.0 : 0.0,
+      pbase->transactions_per_op,
+      results[i].transactions_per_op,
+      pbase->bytes_per_op,
+      results[i].bytes_per_op
+    );
+  }
+
+  // A baseline case the run skipped, renamed or dropped would otherwise pass unnoticed.
+  for (size_t k = 0; k < baseline_count; k++) {
+    if (filter != NULL && strstr(baseline[k].name, filter) == NULL) {
+      continue;
+    }
+    bool found = false;
+    for (size_t i = 0; i < count && !found; i++) {
+      found = strcmp(baseline[k].name, results[i].name) == 0;
+    }
+    if (!found) {
+      printf("MISS  %-34s\n", baseline[k].name);
+      regressions++;
+    }
+  }
+
+  return regressions;
+}
+
+int main(int argc, char **argv) {
+  const char *json_path = NULL;
+  const char *compare_path = NULL;
+  const char *filter = NULL;
+  double threshold = 10.0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      json_path = argv[++i];
+    } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+      compare_path = argv[++i];
+    } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      fprintf(
+        stderr,
+        "usage: %s [--json <out>] [--compare <baseline> [--threshold <percent>]] [--filter <text>]\n",
+        argv[0]
+      );
+      return 2;
+    }
+  }
+
+  static bench_result_t results[BENCH_CASE_MAX];
+  size_t count = 0;
+  printf("%-34s %12s %12s %10s %10s\n", "case", "ns/op", "cycles/op", "tx/op", "B/op");
+  for (size_t i = 0; i < BENCH_CASE_COUNT && count < BENCH_CASE_MAX; i++) {
+    if (filter != NULL && strstr(bench_cases[i].name, filter) == NULL) {
+      continue;
+    }
+    if (bench_run(&bench_cases[i], &results[count]) != 0) {
+      fprintf(stderr, "%s: setup failed\n", bench_cases[i].name);
+      return 1;
+    }
+    printf(
+      "%-34s %12.1f %12.1f %10.2f %10.2f\n",
+      results[count].name,
+      results[count].ns_per_op,
+      results[count].cycles_per_op,
+      results[count].transactions_per_op,
+      results[count].bytes_per_op
+    );
+    count++;
+  }
+
+  if (json_path != NULL && bench_write_json(json_path, results, count) != 0) {
+    return 1;
+  }
+
+  if (compare_path != NULL) {
+    static bench_result_t baseline[BENCH_CASE_MAX];
+    size_t baseline_count = 0;
+    if (bench_read_json(compare_path, baseline, &baseline_count) != 0) {
+      return 1;
+    }
+    printf("\ncompare with %s, threshold %.1f %%\n", compare_path, threshold);
+    const int regressions = bench_compare(results, count, baseline, baseline_count, threshold, filter);
+    if (regressions > 0) {
+      printf("%d regression(s)\n", regressions);
+      return 1;
+    }
+    printf("no regressions\n");
+  }
+
+  return 0;
+}
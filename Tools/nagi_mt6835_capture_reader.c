@@ -0,0 +1,191 @@
+/// Linux reader for mt6835 capture streams, see nagi_mt6835_capture.h for the format.
+///
+/// nagi_mt6835_capture_reader <dump> csv             CSV on stdout
+/// nagi_mt6835_capture_reader <dump> npy <prefix>    one .npy array per field, <prefix>_<field>.npy
+///
+/// The dump is memory mapped, records are decoded in place.
+///
+/// cc -O2 -IInc Tools/nagi_mt6835_capture_reader.c Src/nagi_mt6835_capture.c Src/nagi_mt6835.c -lm
+
+#include "nagi_mt6835_capture.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @brief Field of the npy export.
+typedef struct reader_field_t {
+  /// @brief File name suffix.
+  const char *name;
+  /// @brief numpy dtype.
+  const char *descr;
+  /// @brief Element size.
+  size_t size;
+} reader_field_t;
+
+static const reader_field_t reader_fields[] = {
+  {"timestamp", "<u8", 8},
+  {"raw_angle", "<u4", 4},
+  {"warning", "|u1", 1},
+  {"crc_ok", "|u1", 1},
+  {"angle_flags", "|u1", 1},
+  {"gap", "|u1", 1},
+};
+
+#define READER_FIELD_COUNT (sizeof(reader_fields) / sizeof(reader_fields[0]))
+
+/// @brief Write a npy version 1.0 header.
+/// @param file output file.
+/// @param descr numpy dtype.
+/// @param count element count.
+/// @return 0 on success.
+static int reader_write_npy_header(FILE *file, const char *descr, size_t count) {
+  char dict[128];
+  int len = snprintf(dict, sizeof(dict), "{'descr': '%s', 'fortran_order': False, 'shape': (%zu,), }", descr, count);
+  // Magic, version and length take 10 bytes, pad the dict with spaces to a 64 byte boundary.
+  const size_t total = (10 + (size_t)len + 1 + 63) & ~(size_t)63;
+  const uint16_t header_len = (uint16_t)(total - 10);
+  const uint8_t preamble[10] = {
+    0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0, (uint8_t)header_len, (uint8_t)(header_len >> 8)
+  };
+
+  if (fwrite(preamble, 1, sizeof(preamble), file) != sizeof(preamble)) {
+    return -1;
+  }
+  fputs(dict, file);
+  for (size_t i = 10 + (size_t)len; i < total - 1; i++) {
+    fputc(' ', file);
+  }
+  fputc('\n', file);
+  return ferror(file) ? -1 : 0;
+}
+
+/// @brief Write one field of a decoded record.
+/// @param file output file.
+/// @param field field index.
+/// @param precord record.
+static void reader_write_field(FILE *file, size_t field, const nagi_mt6835_capture_record_t *precord) {
+  uint8_t data[8];
+  uint64_t value = 0;
+  switch (field) {
+    case 0: value = precord->timestamp; break;
+    case 1: value = precord->raw_angle; break;
+    case 2: value = (uint64_t)precord->warning; break;
+    case 3: value = precord->crc_ok; break;
+    case 4: value = precord->angle_flags; break;
+    default: value = precord->gap; break;
+  }
+  for (size_t i = 0; i < reader_fields[field].size; i++) {
+    data[i] = (uint8_t)(value >> (8 * i));
+  }
+  fwrite(data, 1, reader_fields[field].size, file);
+}
+
+/// @brief Export records as CSV.
+/// @param records first record.
+/// @param count record count.
+/// @param format record format.
+/// @param timer_hz timestamp tick rate in Hz, 0 if unknown.
+/// @return 0 on success.
+static int reader_export_csv(const uint8_t *records, size_t count, nagi_mt6835_capture_format_enum_t format, uint32_t timer_hz) {
+  printf("timestamp,%sraw_angle,degree,warning,crc_ok,angle_flags,gap\n", timer_hz != 0 ? "time_s," : "");
+  for (size_t i = 0; i < count; i++) {
+    nagi_mt6835_capture_record_t record;
+    nagi_mt6835_capture_decode_record(records + i * (size_t)format, format, &record);
+    printf("%" PRIu64 ",", record.timestamp);
+    if (timer_hz != 0) {
+      printf("%.9f,", (double)record.timestamp / (double)timer_hz);
+    }
+    printf(
+      "%" PRIu32 ",%.6f,%u,%u,%u,%u\n",
+      record.raw_angle,
+      (double)record.raw_angle * 360.0 / NAGI_MT6835_ANGLE_RESOLUTION,
+      (unsigned int)record.warning,
+      (unsigned int)record.crc_ok,
+      (unsigned int)record.angle_flags,
+      (unsigned int)record.gap
+    );
+  }
+  return ferror(stdout) ? -1 : 0;
+}
+
+/// @brief Export records as one npy file per field.
+/// @param records first record.
+/// @param count record count.
+/// @param format record format.
+/// @param prefix output path prefix.
+/// @return 0 on success.
+static int reader_export_npy(const uint8_t *records, size_t count, nagi_mt6835_capture_format_enum_t format, const char *prefix) {
+  for (size_t field = 0; field < READER_FIELD_COUNT; field++) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s_%s.npy", prefix, reader_fields[field].name);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+      perror(path);
+      return -1;
+    }
+    int err = reader_write_npy_header(file, reader_fields[field].descr, count);
+    for (size_t i = 0; err == 0 && i < count; i++) {
+      nagi_mt6835_capture_record_t record;
+      nagi_mt6835_capture_decode_record(records + i * (size_t)format, format, &record);
+      reader_write_field(file, field, &record);
+    }
+    if (fclose(file) != 0 || err != 0) {
+      perror(path);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3 || (strcmp(argv[2], "csv") != 0 && (strcmp(argv[2], "npy") != 0 || argc < 4))) {
+    fprintf(stderr, "usage: %s <dump> csv\n       %s <dump> npy <prefix>\n", argv[0], argv[0]);
+    return 2;
+  }
+
+  int fd = open(argv[1], O_RDONLY);
+  if (fd < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < NAGI_MT6835_CAPTURE_HEADER_SIZE) {
+    fprintf(stderr, "%s: not a capture stream\n", argv[1]);
+    close(fd);
+    return 1;
+  }
+  const size_t size = (size_t)st.st_size;
+  const uint8_t *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    perror("mmap");
+    return 1;
+  }
+
+  nagi_mt6835_capture_format_enum_t format = NAGI_MT6835_CAPTURE_FORMAT_8;
+  uint32_t timer_hz = 0;
+  if (nagi_mt6835_capture_parse_header(data, size, &format, &timer_hz) != NAGI_MT6835_OK) {
+    fprintf(stderr, "%s: not a capture stream\n", argv[1]);
+    munmap((void *)data, size);
+    return 1;
+  }
+
+  const size_t payload = size - NAGI_MT6835_CAPTURE_HEADER_SIZE;
+  const size_t count = payload / (size_t)format;
+  if (payload % (size_t)format != 0) {
+    fprintf(stderr, "%s: ignoring %zu trailing bytes\n", argv[1], payload % (size_t)format);
+  }
+
+  const uint8_t *records = data + NAGI_MT6835_CAPTURE_HEADER_SIZE;
+  int err = strcmp(argv[2], "csv") == 0
+    ? reader_export_csv(records, count, format, timer_hz)
+    : reader_export_npy(records, count, format, argv[3]);
+
+  munmap((void *)data, size);
+  return err == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/// Exhaustive accuracy check of the nagi_mt6835_foc.h table sin / cos against libm.
+///
+/// nagi_mt6835_foc_check [max pole pairs]
+///
+/// Runs nagi_mt6835_foc_update_q15 and nagi_mt6835_foc_update_f32 on every raw angle for every pole
+/// pair count from 1 to max pole pairs, 21 by default, and compares sin / cos with the double libm
+/// sin / cos of the same electrical angle. Exits with 1 when the Q15 error exceeds 1.6 LSB or the
+/// float error exceeds 3.2e-5, the bounds nagi_mt6835_foc.h documents.
+///
+/// cc -O2 -IInc Tools/nagi_mt6835_foc_check.c Src/nagi_mt6835_foc.c Src/nagi_mt6835.c -lm
+
+#include "nagi_mt6835_foc.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FOC_CHECK_Q15_BOUND (1.6)
+#define FOC_CHECK_F32_BOUND (3.2e-5)
+#define FOC_CHECK_TWO_PI    (6.283185307179586)
+
+/// @brief Largest error seen and where.
+typedef struct foc_check_max_t {
+  /// @brief Error.
+  double error;
+  /// @brief Pole pairs.
+  uint32_t pole_pairs;
+  /// @brief Raw angle.
+  uint32_t raw_angle;
+} foc_check_max_t;
+
+/// @brief Track the largest error.
+/// @param pmax largest error.
+/// @param error error.
+/// @param pole_pairs pole pairs.
+/// @param raw_angle raw angle.
+static void foc_check_track(foc_check_max_t *pmax, double error, uint32_t pole_pairs, uint32_t raw_angle) {
+  if (error > pmax->error) {
+    pmax->error = error;
+    pmax->pole_pairs = pole_pairs;
+    pmax->raw_angle = raw_angle;
+  }
+}
+
+int main(int argc, char **argv) {
+  const long max_pole_pairs = argc > 1 ? strtol(argv[1], NULL, 0) : 21;
+  if (argc > 2 || max_pole_pairs < 1 || max_pole_pairs > 1024) {
+    fprintf(stderr, "usage: %s [max pole pairs 1 - 1024]\n", argv[0]);
+    return 2;
+  }
+
+  foc_check_max_t q15 = {0};
+  foc_check_max_t f32 = {0};
+  for (uint32_t pole_pairs = 1; pole_pairs <= (uint32_t)max_pole_pairs; pole_pairs++) {
+    nagi_mt6835_foc_t foc;
+    if (nagi_mt6835_foc_init(&foc, pole_pairs, 0) != NAGI_MT6835_OK) {
+      fprintf(stderr, "nagi_mt6835_foc_init failed\n");
+      return 2;
+    }
+
+    for (uint32_t raw_angle = 0; raw_angle < NAGI_MT6835_ANGLE_RESOLUTION; raw_angle++) {
+      nagi_mt6835_foc_q15_t out_q15;
+      nagi_mt6835_foc_f32_t out_f32;
+      nagi_mt6835_foc_update_q15(&foc, raw_angle, &out_q15);
+      nagi_mt6835_foc_update_f32(&foc, raw_angle, &out_f32);
+
+      const double theta = (double)out_q15.angle * (FOC_CHECK_TWO_PI / 4294967296.0);
+      const double s = sin(theta);
+      const double c = cos(theta);
+      foc_check_track(&q15, fabs(out_q15.sin - NAGI_MT6835_FOC_Q15_ONE * s), pole_pairs, raw_angle);
+      foc_check_track(&q15, fabs(out_q15.cos - NAGI_MT6835_FOC_Q15_ONE * c), pole_pairs, raw_angle);
+      foc_check_track(&f32, fabs(out_f32.sin - s), pole_pairs, raw_angle);
+      foc_check_track(&f32, fabs(out_f32.cos - c), pole_pairs, raw_angle);
+    }
+  }
+
+  printf(
+    "pole pairs 1 - %ld, q15 max error %.3f LSB (pole pairs %u, raw angle %u), "
+    "f32 max error %.3g (pole pairs %u, raw angle %u)\n",
+    max_pole_pairs,
+    q15.error,
+    q15.pole_pairs,
+    q15.raw_angle,
+    f32.error,
+    f32.pole_pairs,
+    f32.raw_angle
+  );
+  if (q15.error > FOC_CHECK_Q15_BOUND || f32.error > FOC_CHECK_F32_BOUND) {
+    printf("FAIL: bounds are %.1f LSB and %.1e\n", FOC_CHECK_Q15_BOUND, FOC_CHECK_F32_BOUND);
+    return 1;
+  }
+  return 0;
+}
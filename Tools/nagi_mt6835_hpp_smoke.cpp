@@ -0,0 +1,95 @@
+/// C++17 smoke test, builds every C header as C++, links the C objects and checks the header-only
+/// driver over mt6835_ctx_transport reads the same angles from the simulator as the C driver.
+///
+/// nagi_mt6835_hpp_smoke
+///
+/// Exits with 1 when an init fails or an angle differs.
+///
+/// cc -O2 -c -IInc Src/*.c && c++ -std=c++17 -O2 -IInc Tools/nagi_mt6835_hpp_smoke.cpp *.o -lm
+
+#include "nagi_mt6835.hpp"
+
+#include "nagi_mt6835_batch.h"
+#include "nagi_mt6835_bus.h"
+#include "nagi_mt6835_calib.h"
+#include "nagi_mt6835_capture.h"
+#include "nagi_mt6835_filter.h"
+#include "nagi_mt6835_foc.h"
+#include "nagi_mt6835_health.h"
+#include "nagi_mt6835_multiturn.h"
+#include "nagi_mt6835_observer.h"
+#include "nagi_mt6835_profile.h"
+#include "nagi_mt6835_pub.h"
+#include "nagi_mt6835_sim.h"
+#include "nagi_mt6835_spidev.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr int smoke_reads = 1000;
+constexpr int32_t smoke_velocity = 12345;
+
+/// @brief Set up a simulator turning at smoke_velocity.
+/// @param psim simulator.
+/// @return true on success.
+bool smoke_sim_init(nagi_mt6835_sim_t *psim) {
+  const nagi_mt6835_sim_trajectory_t trajectory = {
+    NAGI_MT6835_SIM_TRAJECTORY_VELOCITY, 1000, smoke_velocity, nullptr, nullptr
+  };
+  return nagi_mt6835_sim_init(psim) == NAGI_MT6835_OK &&
+         nagi_mt6835_sim_set_trajectory(psim, &trajectory) == NAGI_MT6835_OK;
+}
+
+} // namespace
+
+int main() {
+  static nagi_mt6835_sim_t sim_cpp;
+  static nagi_mt6835_sim_t sim_c;
+  if (!smoke_sim_init(&sim_cpp) || !smoke_sim_init(&sim_c)) {
+    std::fprintf(stderr, "simulator init failed\n");
+    return 1;
+  }
+
+  nagi::mt6835<nagi::mt6835_ctx_transport, nagi::mt6835_crc_check, nagi::mt6835_unit_raw> encoder{
+    {nagi_mt6835_sim_chip_select_ctx, nagi_mt6835_sim_read_write_ctx, &sim_cpp}
+  };
+
+  nagi_mt6835_config_t config;
+  nagi_mt6835_t mt6835;
+  if (nagi_mt6835_sim_make_ctx_config(&sim_c, &config, true) != NAGI_MT6835_OK ||
+      nagi_mt6835_init(&mt6835, &config) != NAGI_MT6835_OK) {
+    std::fprintf(stderr, "mt6835 init failed\n");
+    return 1;
+  }
+
+  // A few module entry points, so the link covers more than the core driver.
+  static nagi_mt6835_pub_t pub;
+  nagi_mt6835_multiturn_t tracker;
+  if (nagi_mt6835_pub_init(&pub) != NAGI_MT6835_OK || nagi_mt6835_pub_attach(&mt6835, &pub) != NAGI_MT6835_OK ||
+      nagi_mt6835_multiturn_init(&tracker, 0, NAGI_MT6835_ANGLE_RESOLUTION / 4) != NAGI_MT6835_OK) {
+    std::fprintf(stderr, "module init failed\n");
+    return 1;
+  }
+
+  int mismatches = 0;
+  for (int i = 0; i < smoke_reads; i++) {
+    uint32_t angle_cpp = 0;
+    uint32_t angle_c = 0;
+    const nagi_mt6835_error_t err_cpp = encoder.get_raw_angle(angle_cpp);
+    const nagi_mt6835_error_t err_c =
+      nagi_mt6835_get_raw_angle(&mt6835, NAGI_MT6835_READ_ANGLE_METHOD_CONTINUE, &angle_c);
+    if (err_cpp != NAGI_MT6835_OK || err_c != NAGI_MT6835_OK || angle_cpp != angle_c) {
+      mismatches++;
+    }
+  }
+
+  nagi_mt6835_sample_t sample;
+  if (nagi_mt6835_pub_read(&pub, &sample) != NAGI_MT6835_OK || sample.seq != smoke_reads - 1) {
+    std::fprintf(stderr, "publication missed samples\n");
+    return 1;
+  }
+
+  std::printf("reads %d, mismatches %d\n", smoke_reads, mismatches);
+  return mismatches != 0 ? 1 : 0;
+}
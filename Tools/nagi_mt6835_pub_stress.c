@@ -0,0 +1,112 @@
+/// Linux stress test of the lock free sample publication, one writer and several reader threads.
+///
+/// nagi_mt6835_pub_stress [samples] [readers]
+///
+/// The writer publishes samples whose fields are all functions of the sequence number, readers
+/// check every copy they get against it and that the sequence never goes back. Exits with 1 on any
+/// torn or stale read. Defaults are 50000000 samples and 4 readers, run it on a multi core host to
+/// race the threads on real caches, on one core the preemption races them.
+///
+/// cc -O2 -pthread -IInc Tools/nagi_mt6835_pub_stress.c Src/nagi_mt6835_pub.c Src/nagi_mt6835.c -lm
+
+#include "nagi_mt6835_pub.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STRESS_READER_MAX (64)
+
+/// @brief Reader thread state.
+typedef struct stress_reader_t {
+  /// @brief Thread.
+  pthread_t thread;
+  /// @brief Successful reads.
+  uint64_t reads;
+  /// @brief Reads with fields not matching their sequence number.
+  uint64_t torn;
+  /// @brief Reads older than a previous one.
+  uint64_t stale;
+} stress_reader_t;
+
+static nagi_mt6835_pub_t stress_pub;
+static atomic_bool stress_done;
+
+/// @brief Expected sample of a sequence number.
+/// @param seq sequence number.
+/// @param psample sample.
+static void stress_sample(uint32_t seq, nagi_mt6835_sample_t *psample) {
+  psample->raw_angle = (seq * 7919u) & (NAGI_MT6835_ANGLE_RESOLUTION - 1);
+  psample->timestamp = seq * 3u + 1u;
+  psample->seq = seq;
+  psample->warning = (nagi_mt6835_warning_t)(seq & 0x07);
+  psample->crc_ok = (seq >> 3) & 0x01;
+  psample->angle_flags = (uint8_t)((seq >> 4) & 0x1F);
+}
+
+static void *stress_read(void *arg) {
+  stress_reader_t *preader = (stress_reader_t *)arg;
+  uint32_t last_seq = 0;
+
+  while (!atomic_load_explicit(&stress_done, memory_order_relaxed)) {
+    nagi_mt6835_sample_t sample;
+    if (nagi_mt6835_pub_read(&stress_pub, &sample) != NAGI_MT6835_OK) {
+      continue;
+    }
+
+    nagi_mt6835_sample_t expected;
+    stress_sample(sample.seq, &expected);
+    if (sample.raw_angle != expected.raw_angle || sample.timestamp != expected.timestamp ||
+        sample.warning != expected.warning || sample.crc_ok != expected.crc_ok ||
+        sample.angle_flags != expected.angle_flags) {
+      preader->torn++;
+    }
+    if (sample.seq < last_seq) {
+      preader->stale++;
+    }
+    last_seq = sample.seq;
+    preader->reads++;
+  }
+
+  return NULL;
+}
+
+int main(int argc, char **argv) {
+  const uint32_t samples = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 50000000u;
+  const int readers = argc > 2 ? atoi(argv[2]) : 4;
+  if (samples == 0 || readers < 1 || readers > STRESS_READER_MAX) {
+    fprintf(stderr, "usage: %s [samples] [readers 1 - %d]\n", argv[0], STRESS_READER_MAX);
+    return 2;
+  }
+
+  static stress_reader_t reader[STRESS_READER_MAX];
+  nagi_mt6835_pub_init(&stress_pub);
+  for (int i = 0; i < readers; i++) {
+    if (pthread_create(&reader[i].thread, NULL, stress_read, &reader[i]) != 0) {
+      fprintf(stderr, "pthread_create failed\n");
+      return 2;
+    }
+  }
+
+  for (uint32_t seq = 1; seq <= samples; seq++) {
+    nagi_mt6835_sample_t sample;
+    stress_sample(seq, &sample);
+    nagi_mt6835_pub_publish(&stress_pub, &sample);
+  }
+  atomic_store_explicit(&stress_done, true, memory_order_relaxed);
+
+  uint64_t reads = 0;
+  uint64_t torn = 0;
+  uint64_t stale = 0;
+  for (int i = 0; i < readers; i++) {
+    pthread_join(reader[i].thread, NULL);
+    reads += reader[i].reads;
+    torn += reader[i].torn;
+    stale += reader[i].stale;
+  }
+
+  printf("samples %u, readers %d, reads %llu, torn %llu, stale %llu\n", samples, readers,
+         (unsigned long long)reads, (unsigned long long)torn, (unsigned long long)stale);
+  return torn != 0 || stale != 0 ? 1 : 0;
+}